@@ -24,6 +24,7 @@
 #include "game/SplashScreen.h"
 #include "engine/gfx/Gfx.h"
 #include "engine/sfx/Sfx.h"
+#include "engine/core/JobSystem.h"
 #include "engine/core/AssetManager.h"
 #include "engine/ecs/EntityManager.h"
 #include "engine/core/SceneManager.h"
@@ -44,6 +45,7 @@ void setUp() {
     Sfx::getInstance()->setSfxContext();
     AssetManager::getInstance()->load();
     EntityManager::getInstance();
+    JobSystem::getInstance();
 }
 
 void quit() {
@@ -51,5 +53,6 @@ void quit() {
     delete Sfx::getInstance();
     delete AssetManager::getInstance();
     delete EntityManager::getInstance();
+    delete JobSystem::getInstance();
     SDL_Quit();
 }
@@ -27,7 +27,12 @@
 #include <map>
 #include <list>
 #include <array>
+#include <deque>
 #include <cmath>
+#include <cassert>
+#include <mutex>
+#include <atomic>
+#include <bitset>
 #include <limits>
 #include <vector>
 #include <random>
@@ -35,6 +40,8 @@
 #include <future>
 #include <string>
 #include <thread>
+#include <cstddef>
+#include <cstdint>
 #include <variant>
 #include <utility>
 #include <fstream>
@@ -45,6 +52,7 @@
 #include <functional>
 #include <unordered_map>
 #include <unordered_set>
+#include <condition_variable>
 
 // SDL2 includes
 #include <SDL2/SDL.h>
@@ -48,6 +48,10 @@ void AssetManager::addSound(const std::string& name, const std::string& filePath
 	this->sounds.emplace(name, sound);
 }
 
+void AssetManager::addPath(const std::string& name, const std::vector<Vec2>& points) {
+    this->paths[name] = WaypointPath::create(points);
+}
+
 SDL_Texture* AssetManager::getTexture(const std::string& name) {
     return textures[name].second;
 }
@@ -56,6 +60,11 @@ Mix_Chunk* AssetManager::getSound(const std::string& name) {
 	return sounds[name];
 }
 
+std::shared_ptr<const WaypointPath> AssetManager::getPath(const std::string& name) const {
+    auto it = paths.find(name);
+    return it != paths.end() ? it->second : nullptr;
+}
+
 int AssetManager::textureCount() const {
     return (int)textures.size();
 }
@@ -96,4 +105,7 @@ void AssetManager::clearAssets() {
         Mix_FreeChunk(sound.second);
     }
     this->sounds.clear();
+
+    // Entities that follow a path keep it alive
+    this->paths.clear();
 }
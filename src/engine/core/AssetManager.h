@@ -21,6 +21,7 @@
 */
 #pragma once
 #include "../../Pch.h"
+#include "../math/WaypointPath.h"
 
 /**
 * @class AssetManager
@@ -30,10 +31,12 @@ class AssetManager final {
 private:
     using sound_t   = std::map<std::string, Mix_Chunk*>;
     using texture_t = std::map<std::string, std::pair<short, SDL_Texture*>>;
+    using path_t    = std::map<std::string, std::shared_ptr<const WaypointPath>>;
    
     inline static AssetManager* instance = nullptr;
     sound_t sounds;
     texture_t textures;
+    path_t paths;
     
     AssetManager() = default;
 
@@ -69,6 +72,14 @@ public:
      */
     void addTexture(const std::string& name, const short value, const std::string& filePath);
     
+    /**
+     * @brief Adds a waypoint path to the AssetManager, shared by every entity that follows it.
+     * 
+     * @param name The name of the path.
+     * @param points The points of the path.
+     */
+    void addPath(const std::string& name, const std::vector<Vec2>& points);
+
     /**
      * @brief Gets a sound from the AssetManager.
      * 
@@ -84,6 +95,14 @@ public:
      * @return The texture.
      */
     SDL_Texture* getTexture(const std::string& name);
+
+    /**
+     * @brief Gets a waypoint path from the AssetManager.
+     * 
+     * @param name The name of the path.
+     * @return The path, or nullptr if there is no path with the name.
+     */
+    std::shared_ptr<const WaypointPath> getPath(const std::string& name) const;
     
     /**
      * @brief Gets the number of sounds in the AssetManager.
@@ -90,14 +90,4 @@ public:
 	static int getCpuCount() {
 		return cpuCount;
 	}
-
-	/**
-	 * @brief Get the number of threads to use based on the size of the data.
-	 * @param size The size of the data.
-	 * @return The number of threads to use.
-	 */
-	static int getThreadNumber(int size) {
-		if (size < 1001) return 2;
-    	return std::min((size / 1000) + 2, cpuCount);
- 	}
 };
@@ -0,0 +1,143 @@
+/**
+* @file JobSystem.cpp
+* @author Hudson Schumaker
+* @brief Implements the JobSystem class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "JobSystem.h"
+#include "Hardware.h"
+
+JobSystem::JobSystem() {
+	// Leave one core to the main thread, which also runs jobs while it waits
+	int workerCount = std::max(1, Hardware::getCpuCount() - 1);
+
+	for (int i = 0; i < workerCount; i++) {
+		queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	for (int i = 0; i < workerCount; i++) {
+		workers.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		isRunning = false;
+	}
+	sleepCondition.notify_all();
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+JobSystem* JobSystem::getInstance() {
+	if (instance == nullptr) {
+		instance = new JobSystem();
+	}
+
+	return instance;
+}
+
+int JobSystem::getWorkerCount() const {
+	return static_cast<int>(workers.size());
+}
+
+void JobSystem::workerLoop(int index) {
+	workerIndex = index;
+
+	while (isRunning) {
+		if (tryRunJob(index)) {
+			continue;
+		}
+
+		// Sleep until a job is queued
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepCondition.wait(lock, [this] {
+			return !isRunning || pendingJobs > 0;
+		});
+	}
+}
+
+bool JobSystem::tryRunJob(int index) {
+	Job job;
+	bool hasJob = false;
+
+	// Own jobs are taken from the back, the most recent ones are still in cache
+	if (index >= 0) {
+		WorkQueue& queue = *queues[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty()) {
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			hasJob = true;
+		}
+	}
+
+	// Steal from the front of the other queues
+	size_t queueCount = queues.size();
+	for (size_t i = 1; !hasJob && i <= queueCount; i++) {
+		WorkQueue& queue = *queues[(index + i) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty()) {
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			hasJob = true;
+		}
+	}
+
+	if (!hasJob) {
+		return false;
+	}
+
+	pendingJobs--;
+	job.task();
+	job.counter->fetch_sub(1);
+	return true;
+}
+
+void JobSystem::submit(const std::function<void()>& task, JobCounter& counter) {
+	counter.fetch_add(1);
+
+	// Workers push to their own queue, other threads spread the jobs
+	size_t index = workerIndex >= 0 ? workerIndex : nextQueue++ % queues.size();
+	{
+		WorkQueue& queue = *queues[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back({ task, &counter });
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		pendingJobs++;
+	}
+	sleepCondition.notify_one();
+}
+
+bool JobSystem::runPendingJob() {
+	return tryRunJob(workerIndex);
+}
+
+void JobSystem::wait(JobCounter& counter) {
+	while (counter > 0) {
+		if (!tryRunJob(workerIndex)) {
+			std::this_thread::yield();
+		}
+	}
+}
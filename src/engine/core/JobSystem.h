@@ -0,0 +1,137 @@
+/**
+* @file JobSystem.h
+* @author Hudson Schumaker
+* @brief Defines the JobSystem class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+
+/**
+* @brief Number of jobs of a batch still to finish, JobSystem::wait() returns when it reaches zero.
+*/
+using JobCounter = std::atomic<int>;
+
+/**
+* @class JobSystem
+* @brief Singleton pool of persistent worker threads with work-stealing queues.
+*
+* Each worker owns a queue: it pops its own jobs from the back and, when it runs out of
+* work, steals from the front of the other queues. Threads are created once, so running
+* parallel work every frame costs a queue push per job instead of a thread creation.
+* A thread waiting for a batch runs queued jobs while it waits.
+*/
+class JobSystem final {
+private:
+    struct Job {
+        std::function<void()> task;
+        JobCounter* counter = nullptr;
+    };
+
+    struct WorkQueue {
+        std::deque<Job> jobs;
+        std::mutex mutex;
+    };
+
+    inline static JobSystem* instance = nullptr;
+    inline static thread_local int workerIndex = -1;
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::atomic<bool> isRunning = true;
+    std::atomic<size_t> nextQueue = 0;
+    std::atomic<int> pendingJobs = 0;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+
+    JobSystem();
+
+    /**
+    * @brief The loop of each worker thread.
+    * @param index The index of the worker and of its queue.
+    */
+    void workerLoop(int index);
+
+    /**
+    * @brief Runs one job, taken from the own queue first and stolen from the others otherwise.
+    * @param index The index of the calling worker, or -1 for threads that are not workers.
+    * @return True if a job was run, false if all the queues were empty.
+    */
+    bool tryRunJob(int index);
+
+public:
+    ~JobSystem();
+
+    /**
+    * @brief Returns the singleton instance of the JobSystem class.
+    * @return Pointer to the singleton instance.
+    */
+    static JobSystem* getInstance();
+
+    /**
+    * @brief Returns the number of worker threads.
+    * @return The number of workers.
+    */
+    int getWorkerCount() const;
+
+    /**
+    * @brief Queues a job.
+    * @param task The function to run on a worker.
+    * @param counter The counter of the batch of the job, decremented when the job finishes.
+    */
+    void submit(const std::function<void()>& task, JobCounter& counter);
+
+    /**
+    * @brief Runs one queued job on the calling thread, if there is any.
+    * @return True if a job was run, false if all the queues were empty.
+    */
+    bool runPendingJob();
+
+    /**
+    * @brief Blocks until all the jobs of the batch have finished, running queued jobs meanwhile.
+    * @param counter The counter of the batch.
+    */
+    void wait(JobCounter& counter);
+
+    /**
+    * @brief Calls fn(rangeBegin, rangeEnd) for consecutive ranges of grainSize indices in parallel.
+    *
+    * The first range runs on the calling thread, the call returns when all ranges are done.
+    * @param begin The first index.
+    * @param end One past the last index.
+    * @param grainSize The number of indices of each range.
+    * @param fn The function to call for each range.
+    */
+    template<typename F>
+    void parallelFor(size_t begin, size_t end, size_t grainSize, F&& fn) {
+        if (begin >= end) {
+            return;
+        }
+
+        grainSize = std::max<size_t>(grainSize, 1);
+        JobCounter counter = 0;
+
+        for (size_t start = begin + grainSize; start < end; start += grainSize) {
+            size_t stop = std::min(start + grainSize, end);
+            submit([&fn, start, stop] { fn(start, stop); }, counter);
+        }
+
+        fn(begin, std::min(begin + grainSize, end));
+        wait(counter);
+    }
+};
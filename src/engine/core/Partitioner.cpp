@@ -0,0 +1,59 @@
+/**
+* @file Partitioner.cpp
+* @author Hudson Schumaker
+* @brief Implements the Partitioner class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "Partitioner.h"
+#include "JobSystem.h"
+
+size_t Partitioner::getGrainSize(size_t itemCount) const {
+	if (itemCount == 0) {
+		return 1;
+	}
+
+	// Smallest chunk worth a job, given the measured cost of an item
+	size_t grainSize = DEFAULT_GRAIN_SIZE;
+	if (nanosecondsPerItem > 0.0) {
+		grainSize = static_cast<size_t>(TARGET_CHUNK_NANOSECONDS / nanosecondsPerItem);
+	}
+	grainSize = std::clamp<size_t>(grainSize, 1, itemCount);
+
+	// No more chunks than needed to keep every thread busy while others steal
+	size_t threadCount = JobSystem::getInstance()->getWorkerCount() + 1;
+	size_t maxChunks = threadCount * CHUNKS_PER_THREAD;
+	return std::max(grainSize, (itemCount + maxChunks - 1) / maxChunks);
+}
+
+void Partitioner::record(size_t itemCount, long long nanoseconds) {
+	if (itemCount == 0) {
+		return;
+	}
+
+	double cost = static_cast<double>(nanoseconds) / itemCount;
+	if (nanosecondsPerItem == 0.0) {
+		nanosecondsPerItem = cost;
+	}
+	else {
+		nanosecondsPerItem += SMOOTHING * (cost - nanosecondsPerItem);
+	}
+}
+
+double Partitioner::getCostPerItem() const {
+	return nanosecondsPerItem;
+}
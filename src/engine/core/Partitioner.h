@@ -0,0 +1,65 @@
+/**
+* @file Partitioner.h
+* @author Hudson Schumaker
+* @brief Defines the Partitioner class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+
+/**
+* @class Partitioner
+* @brief Picks the grain size of a parallel loop from the measured cost of its items.
+*
+* The cost per item is an exponential moving average of the last frames, so a loop over a
+* few cheap items runs inline on one thread while a loop over many expensive items is split
+* among all the threads, with a few chunks per thread for the workers to steal.
+*/
+class Partitioner final {
+private:
+    constexpr static const double TARGET_CHUNK_NANOSECONDS = 50000.0; // Enough work per job to amortize queueing it
+    constexpr static const double SMOOTHING = 0.2;                     // Weight of the last frame in the average
+    constexpr static const size_t DEFAULT_GRAIN_SIZE = 1024;           // Used until the first measurement
+    constexpr static const size_t CHUNKS_PER_THREAD = 4;
+
+    double nanosecondsPerItem = 0.0;
+
+public:
+    Partitioner() = default;
+    ~Partitioner() = default;
+
+    /**
+    * @brief Returns the number of items of each chunk.
+    * @param itemCount The number of items of the loop.
+    * @return The grain size, at least 1.
+    */
+    size_t getGrainSize(size_t itemCount) const;
+
+    /**
+    * @brief Adds the measurement of a run of the loop to the average cost per item.
+    * @param itemCount The number of items processed.
+    * @param nanoseconds The time spent processing them, summed over all the threads.
+    */
+    void record(size_t itemCount, long long nanoseconds);
+
+    /**
+    * @brief Returns the average cost of an item.
+    * @return The cost in nanoseconds, 0 before the first measurement.
+    */
+    double getCostPerItem() const;
+};
@@ -23,6 +23,7 @@
 #include "../../Pch.h"
 #include "../gfx/Gfx.h"
 #include "../core/Camera.h"
+#include "../ecs/system/SystemScheduler.h"
 
 /**
  * @class Scene
@@ -52,6 +53,11 @@ protected:
     float deltaTime = 0.0f;
     std::string nextScene = "TitleScreen";
 
+    /**
+    * @brief Runs the systems added by the scene, e.g. in load(), concurrently where they do not conflict.
+    */
+    SystemScheduler scheduler;
+
     bool isRunning = false;
     bool isPaused = false;
     bool isLoaded = false;
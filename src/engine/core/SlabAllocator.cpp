@@ -0,0 +1,122 @@
+/**
+* @file SlabAllocator.cpp
+* @author Hudson Schumaker
+* @brief Implements the SlabAllocator and ComponentAllocator classes.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "SlabAllocator.h"
+
+SlabAllocator::SlabAllocator(size_t blockSize, size_t blocksPerSlab) {
+	// Every block must hold a free list node and keep the alignment of new
+	size_t alignment = alignof(std::max_align_t);
+	this->blockSize = ((std::max(blockSize, sizeof(FreeBlock)) + alignment - 1) / alignment) * alignment;
+	this->blocksPerSlab = blocksPerSlab;
+}
+
+SlabAllocator::~SlabAllocator() {
+	reset();
+}
+
+void SlabAllocator::grow() {
+	char* slab = static_cast<char*>(::operator new(blockSize * blocksPerSlab));
+	slabs.push_back(slab);
+
+	// Thread the new blocks in address order, so they are handed out sequentially
+	for (size_t i = blocksPerSlab; i > 0; i--) {
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * blockSize);
+		block->next = freeList;
+		freeList = block;
+	}
+}
+
+void* SlabAllocator::allocate() {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (freeList == nullptr) {
+		grow();
+	}
+
+	FreeBlock* block = freeList;
+	freeList = block->next;
+	usedBlocks++;
+	return block;
+}
+
+void SlabAllocator::deallocate(void* block) {
+	if (block == nullptr) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+	freeBlock->next = freeList;
+	freeList = freeBlock;
+	usedBlocks--;
+}
+
+void SlabAllocator::reset() {
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& slab : slabs) {
+		::operator delete(slab);
+	}
+	slabs.clear();
+	freeList = nullptr;
+	usedBlocks = 0;
+}
+
+size_t SlabAllocator::getUsedBlocks() {
+	std::lock_guard<std::mutex> lock(mutex);
+	return usedBlocks;
+}
+
+size_t SlabAllocator::getBlockSize() const {
+	return blockSize;
+}
+
+std::array<std::unique_ptr<SlabAllocator>, ComponentAllocator::SIZE_CLASSES>& ComponentAllocator::getPools() {
+	static std::array<std::unique_ptr<SlabAllocator>, SIZE_CLASSES> pools = [] {
+		std::array<std::unique_ptr<SlabAllocator>, SIZE_CLASSES> array;
+		for (size_t i = 0; i < SIZE_CLASSES; i++) {
+			array[i] = std::make_unique<SlabAllocator>((i + 1) * GRANULARITY, BLOCKS_PER_SLAB);
+		}
+		return array;
+	}();
+	return pools;
+}
+
+void* ComponentAllocator::allocate(size_t size) {
+	size_t sizeClass = (size + GRANULARITY - 1) / GRANULARITY - 1;
+	if (size == 0 || sizeClass >= SIZE_CLASSES) {
+		return ::operator new(size);
+	}
+	return getPools()[sizeClass]->allocate();
+}
+
+void ComponentAllocator::deallocate(void* block, size_t size) {
+	size_t sizeClass = (size + GRANULARITY - 1) / GRANULARITY - 1;
+	if (size == 0 || sizeClass >= SIZE_CLASSES) {
+		::operator delete(block);
+		return;
+	}
+	getPools()[sizeClass]->deallocate(block);
+}
+
+void ComponentAllocator::reset() {
+	for (auto& pool : getPools()) {
+		pool->reset();
+	}
+}
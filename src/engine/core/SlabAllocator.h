@@ -0,0 +1,132 @@
+/**
+* @file SlabAllocator.h
+* @author Hudson Schumaker
+* @brief Defines the SlabAllocator and ComponentAllocator classes.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+
+/**
+* @class SlabAllocator
+* @brief Fixed-size block allocator that carves blocks out of large slabs.
+*
+* Freed blocks are kept in an intrusive free list and handed out again before a new
+* slab is requested, so bursts of allocations and deallocations of objects of the
+* same size do not hit the global heap. It is safe to use from multiple threads.
+*/
+class SlabAllocator final {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    size_t blockSize = 0;
+    size_t blocksPerSlab = 0;
+    size_t usedBlocks = 0;
+    FreeBlock* freeList = nullptr;
+    std::vector<void*> slabs;
+    std::mutex mutex;
+
+    /**
+    * @brief Allocates a new slab and threads its blocks into the free list.
+    */
+    void grow();
+
+public:
+    /**
+    * @brief Creates an allocator of blocks of the given size.
+    * @param blockSize The size of each block, rounded up to keep blocks aligned.
+    * @param blocksPerSlab The number of blocks of each slab.
+    */
+    SlabAllocator(size_t blockSize, size_t blocksPerSlab);
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    /**
+    * @brief Returns a free block.
+    * @return Pointer to a block of at least blockSize bytes.
+    */
+    void* allocate();
+
+    /**
+    * @brief Returns the block to the free list.
+    * @param block Pointer to a block returned by allocate().
+    */
+    void deallocate(void* block);
+
+    /**
+    * @brief Releases every slab at once, invalidating all the blocks still in use.
+    */
+    void reset();
+
+    /**
+    * @brief Returns the number of blocks currently in use.
+    * @return The number of blocks.
+    */
+    size_t getUsedBlocks();
+
+    /**
+    * @brief Returns the size of each block.
+    * @return The block size in bytes.
+    */
+    size_t getBlockSize() const;
+};
+
+/**
+* @class ComponentAllocator
+* @brief Pools the memory of the components, one SlabAllocator per size class.
+*
+* Components of the same type always fall into the same size class, so a wave of
+* spawned entities reuses the blocks freed by the last wave. Objects bigger than the
+* largest size class are left to the global heap.
+*/
+class ComponentAllocator final {
+private:
+    constexpr static const size_t GRANULARITY = 16;
+    constexpr static const size_t SIZE_CLASSES = 16; // Up to 256 bytes
+    constexpr static const size_t BLOCKS_PER_SLAB = 256;
+
+    /**
+    * @brief Returns the pools, created on first use.
+    * @return Reference to the array of pools, indexed by size class.
+    */
+    static std::array<std::unique_ptr<SlabAllocator>, SIZE_CLASSES>& getPools();
+
+public:
+    /**
+    * @brief Allocates memory for a component.
+    * @param size The size of the component.
+    * @return Pointer to the memory.
+    */
+    static void* allocate(size_t size);
+
+    /**
+    * @brief Frees the memory of a component.
+    * @param block Pointer to the memory.
+    * @param size The size of the component, the same given to allocate().
+    */
+    static void deallocate(void* block, size_t size);
+
+    /**
+    * @brief Releases every slab of every pool, only valid when no pooled component is alive.
+    */
+    static void reset();
+};
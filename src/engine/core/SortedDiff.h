@@ -0,0 +1,60 @@
+/**
+* @file SortedDiff.h
+* @author Hudson Schumaker
+* @brief Defines the SortedDiff class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+
+/**
+* @class SortedDiff
+* @brief Finds what changed between two sorted lists of the same kind, e.g. the contacts of two frames.
+*/
+class SortedDiff final {
+public:
+    /**
+    * @brief Walks both lists together and reports the elements found in one list only.
+    *
+    * Both lists must be sorted by operator< and hold each element once. The callbacks are
+    * called in the order of the elements.
+    * @param previous The old list.
+    * @param current The new list.
+    * @param onRemoved Called with each element of previous that is not in current.
+    * @param onAdded Called with each element of current that is not in previous.
+    */
+    template<typename T, typename Removed, typename Added>
+    static void compare(const std::vector<T>& previous, const std::vector<T>& current, Removed&& onRemoved, Added&& onAdded) {
+        size_t i = 0;
+        size_t j = 0;
+        while (i < previous.size() || j < current.size()) {
+            if (j == current.size() || (i < previous.size() && previous[i] < current[j])) {
+                onRemoved(previous[i]);
+                i++;
+            }
+            else if (i == previous.size() || current[j] < previous[i]) {
+                onAdded(current[j]);
+                j++;
+            }
+            else {
+                i++;
+                j++;
+            }
+        }
+    }
+};
@@ -0,0 +1,98 @@
+/**
+* @file Archetype.cpp
+* @author Hudson Schumaker
+* @brief Implements the Archetype class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "Archetype.h"
+#include "Entity.h"
+
+Archetype::Archetype(const Signature& signature) : signature(signature) {
+	for (size_t family = 0; family < MAX_COMPONENTS; family++) {
+		if (signature.test(family)) {
+			families.push_back(family);
+			columns[family].type = &Component::getType(family);
+		}
+	}
+}
+
+Archetype::~Archetype() {
+	for (size_t family : families) {
+		Column& column = columns[family];
+		for (size_t row = 0; row < entities.size(); row++) {
+			column.type->destroy(column.at(row));
+		}
+		for (char* block : column.blocks) {
+			::operator delete(block);
+		}
+	}
+
+	for (auto& entity : entities) {
+		entity->archetype = nullptr;
+	}
+}
+
+const Signature& Archetype::getSignature() const {
+	return signature;
+}
+
+const std::vector<size_t>& Archetype::getFamilies() const {
+	return families;
+}
+
+size_t Archetype::size() const {
+	return entities.size();
+}
+
+Entity* const* Archetype::getEntities() const {
+	return entities.data();
+}
+
+void Archetype::add(Entity* entity) {
+	// A new block for every column, the values already stored never move
+	if (entities.size() == capacity) {
+		for (size_t family : families) {
+			Column& column = columns[family];
+			column.blocks.push_back(static_cast<char*>(::operator new(column.type->size * ROWS_PER_BLOCK)));
+		}
+		capacity += ROWS_PER_BLOCK;
+	}
+
+	entity->archetype = this;
+	entity->archetypeRow = entities.size();
+	entities.push_back(entity);
+}
+
+Entity* Archetype::remove(size_t row) {
+	size_t last = entities.size() - 1;
+	Entity* moved = nullptr;
+
+	// Swap and pop, keeping the columns dense
+	if (row != last) {
+		moved = entities[last];
+		entities[row] = moved;
+		moved->archetypeRow = row;
+		for (size_t family : families) {
+			Column& column = columns[family];
+			column.type->relocate(column.at(row), column.at(last));
+		}
+	}
+
+	entities.pop_back();
+	return moved;
+}
@@ -0,0 +1,166 @@
+/**
+* @file Archetype.h
+* @author Hudson Schumaker
+* @brief Defines the Archetype class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "component/Component.h"
+
+class Entity;
+
+/**
+* @class Archetype
+* @brief Stores every entity that has exactly the same set of components.
+*
+* Each component type of the set has its own column that stores the component values, row i
+* of every column belongs to the entity at row i of the entity column. The columns grow in
+* blocks of ROWS_PER_BLOCK rows that never move, inside a block a column is a plain array
+* of values (SoA).
+*
+* Adding a row leaves the other rows in place. Removing a row moves the last row into the
+* hole, and an entity that changes its set of components has its values moved to another
+* archetype, so component pointers are only valid until the next structural change of their
+* archetype. Keep an entity id or a ComponentHandle instead.
+*/
+class Archetype final {
+public:
+    constexpr static const size_t ROWS_PER_BLOCK = 64;
+
+private:
+    struct Column {
+        const ComponentType* type = nullptr;
+        std::vector<char*> blocks;
+
+        char* at(size_t row) const {
+            return blocks[row / ROWS_PER_BLOCK] + (row % ROWS_PER_BLOCK) * type->size;
+        }
+    };
+
+    Signature signature;
+    std::vector<size_t> families;
+    std::vector<Entity*> entities;
+    std::array<Column, MAX_COMPONENTS> columns;
+    size_t capacity = 0;
+
+public:
+    Archetype(const Signature& signature);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    /**
+    * @brief Returns the set of component families stored by the archetype.
+    * @return The signature of the archetype.
+    */
+    const Signature& getSignature() const;
+
+    /**
+    * @brief Returns the component families stored by the archetype, in increasing order.
+    * @return Constant reference to the vector of families.
+    */
+    const std::vector<size_t>& getFamilies() const;
+
+    /**
+    * @brief Returns the number of entities stored by the archetype.
+    * @return The number of entities.
+    */
+    size_t size() const;
+
+    /**
+    * @brief Checks if the archetype stores the given component type.
+    * @return True if the component type is part of the signature, false otherwise.
+    */
+    template<typename T>
+    bool has() const {
+        return signature.test(Component::getFamily<T>());
+    }
+
+    /**
+    * @brief Checks if the archetype stores all the component types of the mask.
+    * @param mask The signature of the component types.
+    * @return True if all the component types are part of the signature, false otherwise.
+    */
+    bool hasAll(const Signature& mask) const {
+        return (signature & mask) == mask;
+    }
+
+    /**
+    * @brief Checks if the archetype stores all the given component types.
+    * @return True if all the component types are part of the signature, false otherwise.
+    */
+    template<typename... T>
+    bool hasAll() const {
+        return hasAll(Component::getSignature<T...>());
+    }
+
+    /**
+    * @brief Returns the entity column.
+    * @return Pointer to the first entity of the archetype.
+    */
+    Entity* const* getEntities() const;
+
+    /**
+    * @brief Returns one past the last row of the block of the given row.
+    *
+    * The values of the rows [row, getBlockEnd(row)) of a column are contiguous.
+    * @param row The row.
+    * @return The end of the block, not clamped to the size of the archetype.
+    */
+    static size_t getBlockEnd(size_t row) {
+        return (row / ROWS_PER_BLOCK + 1) * ROWS_PER_BLOCK;
+    }
+
+    /**
+    * @brief Returns the component of the given family stored at the given row.
+    * @param family The family, part of the signature.
+    * @param row The row of the entity.
+    * @return Pointer to the value.
+    */
+    void* getComponent(size_t family, size_t row) const {
+        return columns[family].at(row);
+    }
+
+    /**
+    * @brief Returns the component of the given type stored at the given row.
+    * @param row The row of the entity.
+    * @return Pointer to the component.
+    */
+    template<typename T>
+    T* get(size_t row) const {
+        return static_cast<T*>(getComponent(Component::getFamily<T>(), row));
+    }
+
+    /**
+    * @brief Appends a row for the entity, its component values are left for the caller to construct.
+    * @param entity Pointer to the entity to add.
+    */
+    void add(Entity* entity);
+
+    /**
+    * @brief Removes a row, moving the last row into its place.
+    *
+    * The component values of the removed row must have been destroyed or moved away already,
+    * the entity of the row is left untouched.
+    * @param row The row to remove.
+    * @return Pointer to the entity whose row moved, or nullptr.
+    */
+    Entity* remove(size_t row);
+};
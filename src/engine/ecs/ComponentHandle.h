@@ -0,0 +1,68 @@
+/**
+* @file ComponentHandle.h
+* @author Hudson Schumaker
+* @brief Defines the ComponentHandle class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "EntityManager.h"
+
+/**
+* @class ComponentHandle
+* @brief A reference to a component of an entity that stays valid when the component moves.
+*
+* Component pointers are only valid until the next structural change of their archetype. The
+* handle keeps the generational id of the entity instead and resolves the component on use,
+* so it never reaches the component of another entity that reuses the slot.
+*/
+template<typename T>
+class ComponentHandle final {
+private:
+    unsigned long entityId = 0;
+
+public:
+    ComponentHandle() = default;
+    ComponentHandle(const Entity* entity) : entityId(entity ? entity->id : 0) {}
+    ~ComponentHandle() = default;
+
+    /**
+    * @brief Returns the id of the entity that owns the component.
+    * @return The entity id, 0 for an empty handle.
+    */
+    unsigned long getEntityId() const {
+        return entityId;
+    }
+
+    /**
+    * @brief Resolves the component.
+    * @return Pointer to the component, or nullptr if the entity is gone or no longer has it.
+    */
+    T* get() const {
+        Entity* entity = EntityManager::getInstance()->getEntity(entityId);
+        return entity ? entity->getComponent<T>() : nullptr;
+    }
+
+    T* operator->() const {
+        return get();
+    }
+
+    explicit operator bool() const {
+        return get() != nullptr;
+    }
+};
@@ -0,0 +1,56 @@
+/**
+* @file Entity.cpp
+* @author Hudson Schumaker
+* @brief Implements the Entity class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "Entity.h"
+#include "EntityManager.h"
+
+Entity::~Entity() {
+	if (archetype) {
+		EntityManager::getInstance()->removeFromArchetype(this);
+	}
+}
+
+void* Entity::attachComponent(size_t family) {
+	if (signature.test(family)) {
+		Component::getType(family).destroy(archetype->getComponent(family, archetypeRow));
+	}
+	else {
+		signature.set(family);
+		updateArchetype();
+	}
+	return archetype->getComponent(family, archetypeRow);
+}
+
+void Entity::updateArchetype() {
+	EntityManager::getInstance()->moveToArchetype(this);
+}
+
+void Entity::updateGroups() {
+	EntityManager::getInstance()->updateGroups(this);
+}
+
+void Entity::setTag(Tag tag) {
+	EntityManager::getInstance()->changeTag(this, tag);
+}
+
+void Entity::setLayer(Layer layer) {
+	EntityManager::getInstance()->changeLayer(this, layer);
+}
@@ -22,6 +22,8 @@
 #pragma once
 #include "../../Pch.h"
 #include "TLG.h"
+#include "Archetype.h"
+#include "../core/SlabAllocator.h"
 #include "component/Component.h"
 #include "component/Transform.h"
 
@@ -31,32 +33,178 @@
 */
 class Entity final {
 private:
-	std::unordered_map<const std::type_info*, Component*> components;
-
-public:
-	short zIndex = 0;
-	unsigned long id = 0;
+	Signature signature;
+	Archetype* archetype = nullptr;
+	size_t archetypeRow = 0;
+	size_t denseIndex = 0;
+	size_t tagIndex = 0;   // Position in the tag bucket of the EntityManager
+	size_t layerIndex = 0; // Position in the layer bucket of the EntityManager
+	std::array<size_t, GROUP_COUNT> groupIndices; // Position in each group list of the EntityManager, or NO_GROUP
+	bool isDying = false;
+	constexpr static const size_t NO_GROUP = static_cast<size_t>(-1);
 	Layer layer = Layer::MIDDLEGROUND;
-	std::pair<Tag, Tag> tags = { 
+	std::pair<Tag, Tag> tags = {
 		Tag::STANDARD,
 		Tag::STANDARD
 	};
 
+	friend class Archetype;
+	friend class EntityManager;
+	friend class EntityCommandBuffer;
+
+	/**
+	* @brief Returns the pool that stores all the entities.
+	* @return Reference to the pool.
+	*/
+	static SlabAllocator& getPool() {
+		static SlabAllocator pool(sizeof(Entity), 256);
+		return pool;
+	}
+
+	/**
+	* @brief Makes room for a component of the given family in the archetype of the entity.
+	*
+	* An existing component of the family is destroyed, otherwise the entity moves to the
+	* archetype that has the family.
+	* @param family The family of the component.
+	* @return Pointer to the uninitialized value to construct.
+	*/
+	void* attachComponent(size_t family);
+
+	/**
+	* @brief Moves the entity to the archetype of its signature, destroying the components it no longer has.
+	*/
+	void updateArchetype();
+
+	/**
+	* @brief Refreshes the group entries of the entity after its components changed.
+	*/
+	void updateGroups();
+
+public:
+	short zIndex = 0;
+	unsigned long id = 0;
+
 	Entity(unsigned long id, float x, float y) : id(id) {
-		addComponent(new Transform(x, y));
+		groupIndices.fill(NO_GROUP);
+		emplaceComponent<Transform>(x, y);
+	}
+
+	~Entity();
+
+	static void* operator new(size_t size) {
+		return getPool().allocate();
+	}
+
+	static void operator delete(void* block) {
+		getPool().deallocate(block);
+	}
+
+	/**
+	* @brief Creates a component from the given arguments and adds it to the entity.
+	*
+	* The component is moved into the column of the archetype the entity moves to, replacing
+	* the component of the same type if the entity has one.
+	* @param args The arguments of the component constructor.
+	* @return Pointer to the component, valid until the next structural change of its archetype.
+	*/
+	template<typename T, typename... Args>
+	T* emplaceComponent(Args&&... args) {
+		// Built before the entity moves, the arguments may refer to its own components
+		T value(std::forward<Args>(args)...);
+		T* component = ::new (attachComponent(Component::getFamily<T>())) T(std::move(value));
+		component->parentId = id;
+		updateGroups();
+		return component;
 	}
 
-	~Entity() {
-		deleteComponents();
+	/**
+	* @brief Returns the primary and secondary tags of the entity.
+	* @return Constant reference to the pair of tags.
+	*/
+	const std::pair<Tag, Tag>& getTags() const {
+		return tags;
 	}
 
+	/**
+	* @brief Returns the primary tag of the entity, the one EntityManager::getEntitiesWithTag() looks up.
+	* @return The primary tag.
+	*/
+	Tag getTag() const {
+		return tags.first;
+	}
+
+	/**
+	* @brief Sets the primary tag of the entity, moving it to the tag bucket of the EntityManager.
+	* @param tag The new primary tag.
+	*/
+	void setTag(Tag tag);
+
+	/**
+	* @brief Sets the secondary tag of the entity.
+	* @param tag The new secondary tag.
+	*/
+	void setSecondaryTag(Tag tag) {
+		tags.second = tag;
+	}
+
+	/**
+	* @brief Returns the render layer of the entity.
+	* @return The layer.
+	*/
+	Layer getLayer() const {
+		return layer;
+	}
+
+	/**
+	* @brief Sets the render layer of the entity, moving it to the layer bucket of the EntityManager.
+	* @param layer The new layer.
+	*/
+	void setLayer(Layer layer);
+
+	/**
+	* @brief Returns the archetype that currently stores the entity.
+	* @return Pointer to the archetype, or nullptr if the entity is not stored yet.
+	*/
+	Archetype* getArchetype() const {
+		return archetype;
+	}
+
+	/**
+	* @brief Returns the set of component families of the entity.
+	* @return The signature of the entity.
+	*/
+	const Signature& getSignature() const {
+		return signature;
+	}
+
+	/**
+	* @brief Checks if the entity has all the specified components with a single mask test.
+	* @return True if the entity has all the components, false otherwise.
+	*/
+	template<typename... T>
+	bool hasComponents() const {
+		Signature mask = Component::getSignature<T...>();
+		return (signature & mask) == mask;
+	}
+
+	/**
+	* @brief Returns the component of the given family.
+	* @param family The family of the component.
+	* @return Pointer to the component, or nullptr if the entity does not have it.
+	*/
+	Component* getComponent(size_t family) {
+		return signature.test(family) ? Component::getType(family).cast(archetype->getComponent(family, archetypeRow)) : nullptr;
+	}
+
+	/**
+	* @brief Returns the component of the type T.
+	* @return Pointer to the component, valid until the next structural change of its archetype, or nullptr if the entity does not have it.
+	*/
 	template<typename T>
 	T* getComponent() {
-		auto it = components.find(&typeid(T));
-		if (it != components.end()) {
-			return static_cast<T*>(it->second);
-		}
-		return nullptr;
+		size_t family = Component::getFamily<T>();
+		return signature.test(family) ? static_cast<T*>(archetype->getComponent(family, archetypeRow)) : nullptr;
 	}
 
 	template<typename T1, typename T2>
@@ -74,17 +222,42 @@ public:
 		return std::make_tuple(comp1, comp2, comp3);
 	}
 
+	/**
+	* @brief Adds the component to the entity, replacing the component of the same type if the entity has one.
+	*
+	* The value is moved into the column of the archetype and the object passed in is deleted,
+	* use the returned pointer instead.
+	* @param component Pointer to the component, created with new.
+	* @return Pointer to the stored component, valid until the next structural change of its archetype.
+	*/
 	template<typename T>
 	T* addComponent(T* component) {
-		components[&typeid(T)] = component;
-		component->parentId = id;
-		return component;
+		T* stored = ::new (attachComponent(Component::getFamily<T>())) T(std::move(*component));
+		delete component;
+		stored->parentId = id;
+		updateGroups();
+		return stored;
 	}
 
-	void deleteComponents() {
-		for (const auto& entry : components) {
-			delete entry.second;
+	/**
+	* @brief Removes and destroys the component of the type T, if the entity has one.
+	*/
+	template<typename T>
+	void removeComponent() {
+		size_t family = Component::getFamily<T>();
+		if (signature.test(family)) {
+			signature.reset(family);
+			updateArchetype();
+			updateGroups();
 		}
-		components.clear();
+	}
+
+	/**
+	* @brief Removes and destroys all the components of the entity.
+	*/
+	void deleteComponents() {
+		signature.reset();
+		updateArchetype();
+		updateGroups();
 	}
 };
@@ -0,0 +1,100 @@
+/**
+* @file EntityCommandBuffer.cpp
+* @author Hudson Schumaker
+* @brief Implements the EntityCommandBuffer class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "EntityCommandBuffer.h"
+#include "EntityManager.h"
+
+EntityCommandBuffer::~EntityCommandBuffer() {
+	discard();
+}
+
+void EntityCommandBuffer::record(Command&& command) {
+	std::lock_guard<std::mutex> lock(mutex);
+	commands.push_back(std::move(command));
+}
+
+void EntityCommandBuffer::create(float x, float y, Tag tag, const CreateFunction& onCreate) {
+	Command command = { CommandType::CREATE };
+	command.x = x;
+	command.y = y;
+	command.tag = tag;
+	command.onCreate = onCreate;
+	record(std::move(command));
+}
+
+void EntityCommandBuffer::kill(unsigned long id) {
+	record({ CommandType::KILL, id });
+}
+
+void EntityCommandBuffer::playback(EntityManager* manager) {
+	std::vector<Command> pending;
+	std::vector<Entity*> killed;
+
+	// Commands recorded during playback, e.g. by onCreate, are applied in the same pass
+	while (true) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (commands.empty()) {
+				break;
+			}
+			pending.swap(commands);
+		}
+
+		for (auto& command : pending) {
+			if (command.type == CommandType::CREATE) {
+				Entity* entity = manager->createEntity(command.x, command.y, command.tag);
+				if (command.onCreate) {
+					command.onCreate(entity);
+				}
+				continue;
+			}
+
+			Entity* entity = manager->getEntity(command.id);
+			if (entity == nullptr || entity->isDying) {
+				// The entity is gone, the component was never attached
+				delete command.component;
+				continue;
+			}
+
+			if (command.type == CommandType::KILL) {
+				entity->isDying = true;
+				killed.push_back(entity);
+				continue;
+			}
+
+			command.apply(entity, command.component);
+		}
+		pending.clear();
+	}
+
+	// Remove all the killed entities in one pass
+	for (auto& entity : killed) {
+		manager->removeEntity(entity);
+	}
+}
+
+void EntityCommandBuffer::discard() {
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& command : commands) {
+		delete command.component;
+	}
+	commands.clear();
+}
@@ -0,0 +1,122 @@
+/**
+* @file EntityCommandBuffer.h
+* @author Hudson Schumaker
+* @brief Defines the EntityCommandBuffer class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "TLG.h"
+#include "Entity.h"
+
+class EntityManager;
+
+/**
+* @class EntityCommandBuffer
+* @brief Records structural changes to be applied in one batch at the end of the frame.
+*
+* Creating and killing entities or adding and removing components moves entities between
+* archetypes, which is not allowed while systems iterate them. The buffer records those
+* operations instead, it can be used from worker threads, and EntityManager::update()
+* plays them back on the main thread.
+*/
+class EntityCommandBuffer final {
+public:
+    using CreateFunction = std::function<void(Entity*)>;
+
+private:
+    enum class CommandType {
+        CREATE,
+        KILL,
+        ADD_COMPONENT,
+        REMOVE_COMPONENT
+    };
+
+    struct Command {
+        CommandType type;
+        unsigned long id = 0;
+        Component* component = nullptr;
+        void (*apply)(Entity*, Component*) = nullptr;
+        float x = 0.0f;
+        float y = 0.0f;
+        Tag tag = Tag::STANDARD;
+        CreateFunction onCreate = nullptr;
+    };
+
+    std::vector<Command> commands;
+    std::mutex mutex;
+
+    void record(Command&& command);
+
+public:
+    EntityCommandBuffer() = default;
+    ~EntityCommandBuffer();
+
+    /**
+    * @brief Records the creation of an entity.
+    * @param x The x-coordinate of the entity.
+    * @param y The y-coordinate of the entity.
+    * @param tag The tag of the entity.
+    * @param onCreate Called with the new entity during playback, to add its components.
+    */
+    void create(float x, float y, Tag tag, const CreateFunction& onCreate);
+
+    /**
+    * @brief Records the removal of an entity.
+    * @param id The ID of the entity.
+    */
+    void kill(unsigned long id);
+
+    /**
+    * @brief Records the addition of a component, the buffer owns it until playback.
+    * @param id The ID of the entity.
+    * @param component Pointer to the component.
+    */
+    template<typename T>
+    void addComponent(unsigned long id, T* component) {
+        Command command = { CommandType::ADD_COMPONENT, id, component };
+        command.apply = [](Entity* entity, Component* component) {
+            entity->addComponent(static_cast<T*>(component));
+        };
+        record(std::move(command));
+    }
+
+    /**
+    * @brief Records the removal of a component.
+    * @param id The ID of the entity.
+    */
+    template<typename T>
+    void removeComponent(unsigned long id) {
+        Command command = { CommandType::REMOVE_COMPONENT, id };
+        command.apply = [](Entity* entity, Component*) {
+            entity->removeComponent<T>();
+        };
+        record(std::move(command));
+    }
+
+    /**
+    * @brief Applies the recorded commands in order, killing the entities in one batch at the end.
+    * @param manager Pointer to the EntityManager to apply the commands to.
+    */
+    void playback(EntityManager* manager);
+
+    /**
+    * @brief Drops the recorded commands without applying them, deleting the components they carry.
+    */
+    void discard();
+};
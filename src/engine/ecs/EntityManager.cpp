@@ -21,6 +21,9 @@
 */
 #include "EntityManager.h"
 #include "component/Transform.h"
+#include "component/Clickable.h"
+#include "component/BoxCollider.h"
+#include "component/CircleCollider.h"
 #include "../gfx/Box.h"
 #include "../gfx/Line.h"
 #include "../gfx/Circle.h"
@@ -45,14 +48,21 @@ Entity* EntityManager::createEntity() {
 }
 
 Entity* EntityManager::createEntity(const float x, const float y) {
-	Entity* entity = new Entity(++index, x, y);
+	unsigned long slot = acquireSlot();
+	unsigned long id = (generations[slot] << INDEX_BITS) | slot;
+
+	Entity* entity = new Entity(id, x, y);
+	entity->denseIndex = entities.size();
 	entities.push_back(entity);
+	slots[slot] = entity;
+	addToBucket(tagBuckets[static_cast<size_t>(entity->tags.first)], &Entity::tagIndex, entity);
+	addToBucket(layerBuckets[static_cast<size_t>(entity->layer)], &Entity::layerIndex, entity);
 	return entity;
 }
 
 Entity* EntityManager::createEntity(const float x, const float y, Tag tag) {
 	auto entity = createEntity(x, y);
-	entity->tags.first = tag;
+	changeTag(entity, tag);
 
 	if (tag == Tag::PLAYER) {
 		playerId = entity->id;
@@ -62,137 +72,348 @@ Entity* EntityManager::createEntity(const float x, const float y, Tag tag) {
 }
 
 Entity* EntityManager::getEntity(const unsigned long id) {
-	unsigned long low = 0;
-	unsigned long high = static_cast<unsigned long>(entities.size() - 1);
-
-	// search using binary search
-	while (low <= high) {
-		unsigned long mid = (low + high) / 2;
-
-		if (entities[mid]->id == id) {
-			return entities[mid];
-		}
-		else if (entities[mid]->id < id) {
-			low = mid + 1;
-		}
-		else {
-			high = mid - 1;
-		}
+	unsigned long slot = getIndex(id);
+	if (slot >= slots.size()) {
+		return nullptr;
 	}
 
-	return nullptr;
+	// The slot may hold a newer entity, the generation tells them apart
+	Entity* entity = slots[slot];
+	return (entity && entity->id == id) ? entity : nullptr;
+}
+
+bool EntityManager::isAlive(const unsigned long id) {
+	return getEntity(id) != nullptr;
 }
 
 void EntityManager::removeEntity(Entity* entity) {
-	auto it = std::find(entities.begin(), entities.end(), entity);
-	if (it != entities.end()) {
-		delete entity;
-		entities.erase(it);
+	if (entity == nullptr || getEntity(entity->id) != entity) {
+		return;
 	}
+
+	// Swap and pop, keeping the dense array packed
+	Entity* last = entities.back();
+	entities[entity->denseIndex] = last;
+	last->denseIndex = entity->denseIndex;
+	entities.pop_back();
+
+	removeFromBucket(tagBuckets[static_cast<size_t>(entity->tags.first)], &Entity::tagIndex, entity);
+	removeFromBucket(layerBuckets[static_cast<size_t>(entity->layer)], &Entity::layerIndex, entity);
+	removeFromGroups(entity);
+	releaseSlot(entity);
+	delete entity;
 }
 
 void EntityManager::update() {
-	for (auto& e : entitiesToBeKilled) {
-		removeEntity(e);
-	}
-	entitiesToBeKilled.clear();
-	std::sort(entities.begin(), entities.end(), compareAsc);
+	commandBuffer.playback(this);
 }
 
 void EntityManager::killEntity(Entity* entity) {
-	entitiesToBeKilled.insert(entity);
+	commandBuffer.kill(entity->id);
+}
+
+EntityCommandBuffer& EntityManager::getCommandBuffer() {
+	return commandBuffer;
 }
 
 const std::vector<Entity*>& EntityManager::getEntities() const {
 	return entities;
 }
 
-std::vector<Entity*> EntityManager::getEntitiesWithTag(Tag tag) {
-	std::vector<Entity*> list;
-	for (auto& e : entities) {
-		if (e->tags.first == tag) {
-			list.push_back(e);
-		}
+const std::vector<Entity*>& EntityManager::getEntitiesWithTag(Tag tag) const {
+	return tagBuckets[static_cast<size_t>(tag)];
+}
+
+const std::vector<Entity*>& EntityManager::getEntitiesWithLayer(Layer layer) const {
+	return layerBuckets[static_cast<size_t>(layer)];
+}
+
+void EntityManager::addToBucket(std::vector<Entity*>& bucket, size_t Entity::* index, Entity* entity) {
+	entity->*index = bucket.size();
+	bucket.push_back(entity);
+}
+
+void EntityManager::removeFromBucket(std::vector<Entity*>& bucket, size_t Entity::* index, Entity* entity) {
+	// Swap and pop, the moved entity takes the position of the removed one
+	Entity* last = bucket.back();
+	bucket[entity->*index] = last;
+	last->*index = entity->*index;
+	bucket.pop_back();
+}
+
+void EntityManager::changeTag(Entity* entity, Tag tag) {
+	if (entity->tags.first == tag) {
+		return;
 	}
-	return list;
+
+	removeFromBucket(tagBuckets[static_cast<size_t>(entity->tags.first)], &Entity::tagIndex, entity);
+	entity->tags.first = tag;
+	addToBucket(tagBuckets[static_cast<size_t>(tag)], &Entity::tagIndex, entity);
 }
 
-std::vector<Entity*> EntityManager::getEntitiesWithLayer(Layer layer) {
-	std::vector<Entity*> list;
-	for (auto& e : entities) {
-		if (e->layer == layer) {
-			list.push_back(e);
-		}
+void EntityManager::changeLayer(Entity* entity, Layer layer) {
+	if (entity->layer == layer) {
+		return;
+	}
+
+	removeFromBucket(layerBuckets[static_cast<size_t>(entity->layer)], &Entity::layerIndex, entity);
+	removeFromGroups(entity);
+	entity->layer = layer;
+	addToBucket(layerBuckets[static_cast<size_t>(layer)], &Entity::layerIndex, entity);
+	updateGroups(entity);
+}
+
+const std::vector<GroupMember>& EntityManager::getGroup(Group group, Layer layer) const {
+	return groups[static_cast<size_t>(group)][static_cast<size_t>(layer)];
+}
+
+std::vector<GroupMember> EntityManager::getEntitiesWithGroup(Group group) const {
+	std::vector<GroupMember> list;
+	for (auto& members : groups[static_cast<size_t>(group)]) {
+		list.insert(list.end(), members.begin(), members.end());
 	}
 	return list;
 }
 
-std::vector<std::pair<Entity*, std::variant<PrimitiveType, RenderType>>> EntityManager::getEntitiesWithGroup(Group group) {
-	std::vector<std::pair<Entity*, std::variant<PrimitiveType, RenderType>>> list;
-	
-	if (group == Group::RENDERABLE) {
-		for (auto& entity : entities) {
-			if (entity->getComponent<Animation>()) {
-				list.push_back({ entity, RenderType::ANIMATION });
-				continue;
-			}
+bool EntityManager::resolveGroup(Entity* entity, Group group, GroupMember& member) {
+	member.entity = entity;
+	member.transform = entity->getComponent<Transform>();
 
-			if (entity->getComponent<AnimationController>()) {
-				list.push_back({ entity, RenderType::ANIMATION_CONTROLLER });
-				continue;
-			}
-			
-			if (entity->getComponent<Sprite>()) {
-				list.push_back({ entity, RenderType::SPRITE });
-			}
+	// The first component found, in priority order, puts the entity in the group
+	switch (group) {
+	case Group::RENDERABLE:
+		if ((member.component = entity->getComponent<Animation>())) {
+			member.type = RenderType::ANIMATION;
+			return true;
+		}
+		if ((member.component = entity->getComponent<AnimationController>())) {
+			member.type = RenderType::ANIMATION_CONTROLLER;
+			return true;
+		}
+		if ((member.component = entity->getComponent<Sprite>())) {
+			member.type = RenderType::SPRITE;
+			return true;
 		}
-		return list;
+		return false;
+
+	case Group::PRIMITIVES:
+		if ((member.component = entity->getComponent<Box>())) {
+			member.type = PrimitiveType::BOX;
+			return true;
+		}
+		if ((member.component = entity->getComponent<Circle>())) {
+			member.type = PrimitiveType::CIRCLE;
+			return true;
+		}
+		if ((member.component = entity->getComponent<Line>())) {
+			member.type = PrimitiveType::LINE;
+			return true;
+		}
+		return false;
+
+	case Group::COLLIDER:
+		if ((member.component = entity->getComponent<BoxCollider>())) {
+			member.type = ColliderType::BOX;
+			return true;
+		}
+		if ((member.component = entity->getComponent<CircleCollider>())) {
+			member.type = ColliderType::CIRCLE;
+			return true;
+		}
+		return false;
+
+	case Group::CLICKABLE:
+		member.component = entity->getComponent<Clickable>();
+		member.type = std::monostate();
+		return member.component != nullptr;
 	}
 
-	if (group == Group::PRIMITIVES) {
-		for (auto& entity : entities) {
-			if (entity->getComponent<Box>()) {
-				list.push_back({ entity, PrimitiveType::BOX });
-				continue;
-			}
+	return false;
+}
+
+void EntityManager::updateGroups(Entity* entity) {
+	const size_t layer = static_cast<size_t>(entity->layer);
+
+	for (size_t group = 0; group < GROUP_COUNT; group++) {
+		auto& members = groups[group][layer];
+		size_t& index = entity->groupIndices[group];
 
-			if (entity->getComponent<Circle>()) {
-				list.push_back({ entity, PrimitiveType::CIRCLE });
-				continue;
-			}
+		GroupMember member;
+		bool belongs = resolveGroup(entity, static_cast<Group>(group), member);
 
-			if (entity->getComponent<Line>()) {
-				list.push_back({ entity, PrimitiveType::LINE });
-			}
+		if (belongs && index != Entity::NO_GROUP) {
+			// Still a member, the component pointers may have changed
+			members[index] = member;
+		}
+		else if (belongs) {
+			index = members.size();
+			members.push_back(member);
+		}
+		else if (index != Entity::NO_GROUP) {
+			// Swap and pop, the moved member takes the position of the removed one
+			members[index] = members.back();
+			members[index].entity->groupIndices[group] = index;
+			members.pop_back();
+			index = Entity::NO_GROUP;
 		}
-		return list;
 	}
+}
 
-	// TODO: implement other groups
+void EntityManager::removeFromGroups(Entity* entity) {
+	const size_t layer = static_cast<size_t>(entity->layer);
 
-	return list;
-}
+	for (size_t group = 0; group < GROUP_COUNT; group++) {
+		size_t& index = entity->groupIndices[group];
+		if (index == Entity::NO_GROUP) {
+			continue;
+		}
 
-bool EntityManager::compareAsc(const Entity* e1, const Entity* e2) {
-	return (e1->id < e2->id); // For the binary search, when searching an Entity by id.
+		auto& members = groups[group][layer];
+		members[index] = members.back();
+		members[index].entity->groupIndices[group] = index;
+		members.pop_back();
+		index = Entity::NO_GROUP;
+	}
 }
 
 void EntityManager::clear() {
+	// The buffered commands belong to the old entities, and their components must go before the pools
+	commandBuffer.discard();
+
+	// The archetypes destroy all the component values at once, the entities are left without components
+	for (auto& entry : views) {
+		entry.second->clear();
+	}
+	archetypes.clear();
+
 	for (auto& e : entities) {
+		releaseSlot(e);
 		delete e;
 	}
 	entities.clear();
-	index = 0;
+	for (auto& bucket : tagBuckets) {
+		bucket.clear();
+	}
+	for (auto& bucket : layerBuckets) {
+		bucket.clear();
+	}
+	for (auto& layers : groups) {
+		for (auto& members : layers) {
+			members.clear();
+		}
+	}
+}
+
+void EntityManager::reset() {
+	clear();
+	Entity::getPool().reset();
+	ComponentAllocator::reset();
 }
 
 void EntityManager::clear(Entity* entity) {
-	auto it = std::find(entities.begin(), entities.end(), entity);
-	if (it != entities.end()) {
-		delete* it;
-		entities.erase(it);
+	removeEntity(entity);
+}
+
+unsigned long EntityManager::acquireSlot() {
+	if (freeSlots.size() > MINIMUM_FREE_SLOTS) {
+		unsigned long slot = freeSlots.front();
+		freeSlots.pop_front();
+		return slot;
+	}
+
+	// The slot must fit in the index bits of an id, recycle early once they run out
+	if (slots.size() > INDEX_MASK) {
+		if (freeSlots.empty()) {
+			std::cerr << "EntityManager: out of entity slots, " << slots.size() << " entities are alive" << std::endl;
+			std::abort();
+		}
+		unsigned long slot = freeSlots.front();
+		freeSlots.pop_front();
+		return slot;
 	}
+
+	slots.push_back(nullptr);
+	generations.push_back(0);
+	return static_cast<unsigned long>(slots.size() - 1);
+}
+
+void EntityManager::releaseSlot(Entity* entity) {
+	unsigned long slot = getIndex(entity->id);
+	slots[slot] = nullptr;
+	generations[slot] = (generations[slot] + 1) & GENERATION_MASK;
+	freeSlots.push_back(slot);
 }
 
 long int EntityManager::getPlayerId() const {
 	return playerId;
 }
+
+Archetype* EntityManager::getArchetype(const Signature& signature) {
+	std::lock_guard<std::mutex> lock(viewsMutex);
+	auto& archetype = archetypes[signature];
+	if (!archetype) {
+		archetype = std::make_unique<Archetype>(signature);
+		for (auto& entry : views) {
+			entry.second->onArchetypeCreated(archetype.get());
+		}
+	}
+	return archetype.get();
+}
+
+const EntityView* EntityManager::getView(const Signature& mask) {
+	std::lock_guard<std::mutex> lock(viewsMutex);
+	auto& view = views[mask];
+	if (!view) {
+		view = std::make_unique<EntityView>(mask);
+		for (auto& entry : archetypes) {
+			view->onArchetypeCreated(entry.second.get());
+		}
+	}
+	return view.get();
+}
+
+void EntityManager::moveToArchetype(Entity* entity) {
+	Archetype* from = entity->archetype;
+	Archetype* to = getArchetype(entity->signature);
+	if (from == to) {
+		return;
+	}
+
+	size_t fromRow = entity->archetypeRow;
+	to->add(entity);
+	if (from == nullptr) {
+		return;
+	}
+
+	// The values the entity keeps move to the new columns, the others are destroyed
+	for (size_t family : from->getFamilies()) {
+		const ComponentType& type = Component::getType(family);
+		void* value = from->getComponent(family, fromRow);
+		if (to->getSignature().test(family)) {
+			type.relocate(to->getComponent(family, entity->archetypeRow), value);
+		}
+		else {
+			type.destroy(value);
+		}
+	}
+
+	// The entity moved into the hole has new component pointers
+	Entity* moved = from->remove(fromRow);
+	if (moved) {
+		updateGroups(moved);
+	}
+}
+
+void EntityManager::removeFromArchetype(Entity* entity) {
+	Archetype* archetype = entity->archetype;
+	for (size_t family : archetype->getFamilies()) {
+		Component::getType(family).destroy(archetype->getComponent(family, entity->archetypeRow));
+	}
+
+	Entity* moved = archetype->remove(entity->archetypeRow);
+	entity->archetype = nullptr;
+	entity->archetypeRow = 0;
+	if (moved) {
+		updateGroups(moved);
+	}
+}
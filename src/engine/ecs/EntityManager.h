@@ -1,7 +1,7 @@
 /**
 * @file EntityManager.h
 * @author Hudson Schumaker
-* @brief Defines EntityManager, EntityComparator classes
+* @brief Defines EntityManager class
 * @version 1.0.0
 *
 * Dodoi-Engine is a game engine developed by Dodoi-Lab.
@@ -22,40 +22,152 @@
 #pragma once
 #include "../../Pch.h"
 #include "Entity.h"
+#include "Archetype.h"
+#include "EntityView.h"
+#include "GroupMember.h"
+#include "EntityCommandBuffer.h"
 #include "../gfx/GfxTypes.h"
 
 /**
-* @struct EntityComparator
-* @brief A comparator for sorting entities based on their IDs.
+* @struct ArchetypeChunk
+* @brief A contiguous range of rows of an archetype, the unit of work of the parallel systems.
 */
-struct EntityComparator {
-    bool operator()(const Entity* a, const Entity* b) const {
-        return a->id < b->id;
-    }
+struct ArchetypeChunk {
+    Archetype* archetype = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
 };
 
 /**
 * @class EntityManager
 * @brief Singleton class responsible for managing entities in the game engine.
+*
+* Entities with the same set of components are stored together in an Archetype, so
+* systems can iterate the component columns of the matching archetypes instead of
+* probing every entity for its components.
+*
+* Entity ids are generational handles: the low INDEX_BITS are a slot of a sparse set and
+* the high bits are the generation of the slot, bumped each time the slot is released.
+* Looking up, creating and destroying entities are O(1), and a handle to a destroyed
+* entity never resolves to the entity that reuses its slot.
 */
 class EntityManager final {
 private:
-    unsigned long index = 0;
+    constexpr static const unsigned long INDEX_BITS = 20;
+    constexpr static const unsigned long INDEX_MASK = (1ul << INDEX_BITS) - 1;
+    constexpr static const unsigned long GENERATION_MASK = (1ul << (32 - INDEX_BITS)) - 1;
+    constexpr static const size_t MINIMUM_FREE_SLOTS = 1024; // Delays slot reuse, so generations wrap around slowly
+
     unsigned long playerId = 0;
     inline static EntityManager* instance = nullptr;
 
-    std::vector<Entity*> entities;
-    std::set<Entity*, EntityComparator> entitiesToBeKilled;
+    std::vector<Entity*> entities;                 // Dense array of the alive entities
+    std::vector<Entity*> slots = { nullptr };      // Sparse array indexed by slot, slot 0 is never used so no id is 0
+    std::vector<unsigned long> generations = { 0 };
+    std::deque<unsigned long> freeSlots;
+    std::array<std::vector<Entity*>, TAG_COUNT> tagBuckets;     // Entities by primary tag
+    std::array<std::vector<Entity*>, LAYER_COUNT> layerBuckets; // Entities by layer
+    std::array<std::array<std::vector<GroupMember>, LAYER_COUNT>, GROUP_COUNT> groups; // Group members by layer
+    EntityCommandBuffer commandBuffer;
+    std::unordered_map<Signature, std::unique_ptr<Archetype>> archetypes;
+    std::unordered_map<Signature, std::unique_ptr<EntityView>> views;
+    std::mutex viewsMutex; // Systems scheduled at the same time may request views concurrently
+
+    friend class Entity;
 
     EntityManager() = default;
 
     /**
-    * @brief Compares two entities based on their IDs in ascending order.
-    * @param e1 First entity to compare.
-    * @param e2 Second entity to compare.
-    * @return True if the ID of the first entity is less than the ID of the second entity, false otherwise.
+    * @brief Returns the archetype of the given signature, creating it if needed.
+    * @param signature The set of component families.
+    * @return Pointer to the archetype.
+    */
+    Archetype* getArchetype(const Signature& signature);
+
+    /**
+    * @brief Returns the view of the given mask, creating and filling it if needed.
+    * @param mask The set of component families of the view.
+    * @return Pointer to the view.
+    */
+    const EntityView* getView(const Signature& mask);
+
+    /**
+    * @brief Moves the entity to the archetype that matches its current set of components.
+    *
+    * The values of the components the entity keeps are moved to the new archetype and the
+    * others are destroyed. The values of the new components are left for the caller to construct.
+    * @param entity Pointer to the entity to move.
+    */
+    void moveToArchetype(Entity* entity);
+
+    /**
+    * @brief Destroys the component values of the entity and removes it from its archetype.
+    * @param entity Pointer to the entity, stored in an archetype.
+    */
+    void removeFromArchetype(Entity* entity);
+
+    /**
+    * @brief Appends the entity to a bucket, storing its position in the given member of the entity.
+    * @param bucket The tag or layer bucket.
+    * @param index Pointer to the member of Entity that holds the position in the bucket.
+    * @param entity Pointer to the entity.
+    */
+    static void addToBucket(std::vector<Entity*>& bucket, size_t Entity::* index, Entity* entity);
+
+    /**
+    * @brief Removes the entity from a bucket, moving the last entity of the bucket into its place.
+    * @param bucket The tag or layer bucket.
+    * @param index Pointer to the member of Entity that holds the position in the bucket.
+    * @param entity Pointer to the entity.
+    */
+    static void removeFromBucket(std::vector<Entity*>& bucket, size_t Entity::* index, Entity* entity);
+
+    /**
+    * @brief Moves the entity to the bucket of the new tag, called by Entity::setTag().
+    * @param entity Pointer to the entity.
+    * @param tag The new primary tag.
+    */
+    void changeTag(Entity* entity, Tag tag);
+
+    /**
+    * @brief Moves the entity to the bucket of the new layer, called by Entity::setLayer().
+    * @param entity Pointer to the entity.
+    * @param layer The new layer.
+    */
+    void changeLayer(Entity* entity, Layer layer);
+
+    /**
+    * @brief Fills the group entry of the entity from its components.
+    * @param entity Pointer to the entity.
+    * @param group The group.
+    * @param member The entry to fill.
+    * @return True if the entity belongs to the group, false otherwise.
+    */
+    static bool resolveGroup(Entity* entity, Group group, GroupMember& member);
+
+    /**
+    * @brief Adds, refreshes or removes the group entries of the entity after its components changed.
+    * @param entity Pointer to the entity.
+    */
+    void updateGroups(Entity* entity);
+
+    /**
+    * @brief Removes the entity from all its groups.
+    * @param entity Pointer to the entity.
+    */
+    void removeFromGroups(Entity* entity);
+
+    /**
+    * @brief Returns a free slot of the sparse set, reusing released slots first.
+    * @return The slot index.
     */
-    static bool compareAsc(const Entity* e1, const Entity* e2);
+    unsigned long acquireSlot();
+
+    /**
+    * @brief Releases the slot of the entity and bumps its generation.
+    * @param entity Pointer to the entity that owns the slot.
+    */
+    void releaseSlot(Entity* entity);
 
 public:
     ~EntityManager();
@@ -92,10 +204,35 @@ public:
     /**
     * @brief Returns the entity with the specified ID.
     * @param id The ID of the entity.
-    * @return Pointer to the entity if it exists, nullptr otherwise.
+    * @return Pointer to the entity if it exists, nullptr otherwise or if the ID is stale.
     */
     Entity* getEntity(const unsigned long id);
 
+    /**
+    * @brief Checks if the specified ID refers to an alive entity.
+    * @param id The ID of the entity.
+    * @return True if the entity is alive, false if it was removed.
+    */
+    bool isAlive(const unsigned long id);
+
+    /**
+    * @brief Returns the slot index of an entity ID.
+    * @param id The ID of the entity.
+    * @return The slot index.
+    */
+    static unsigned long getIndex(const unsigned long id) {
+        return id & INDEX_MASK;
+    }
+
+    /**
+    * @brief Returns the generation of an entity ID.
+    * @param id The ID of the entity.
+    * @return The generation.
+    */
+    static unsigned long getGeneration(const unsigned long id) {
+        return (id >> INDEX_BITS) & GENERATION_MASK;
+    }
+
     /**
     * @brief Returns a constant reference to the vector of entities.
     * @return Constant reference to the vector of entities.
@@ -108,58 +245,142 @@ public:
     */
     void removeEntity(Entity* entity);
 
+    /**
+    * @brief Returns the persistent view of the entities that have all the specified components.
+    *
+    * Views are created on first use and then kept up to date incrementally, iterating
+    * them does not allocate.
+    * @return The view.
+    */
+    template<typename... T>
+    View<T...> view() {
+        return View<T...>(getView(Component::getSignature<T...>()));
+    }
+
     /**
     * @brief Returns a vector of entities that have the specified component.
     * @return Vector of entities that have the specified component.
     */
     template<typename T>
     std::vector<Entity*> getEntitiesWithComponent() {
-        std::vector<Entity*> list;
-        for (auto& e : entities) {
-            if (e->getComponent<T>()) {
-                list.push_back(e);
+        auto entityView = view<T>();
+        return std::vector<Entity*>(entityView.begin(), entityView.end());
+    }
+
+    /**
+    * @brief Returns the number of entities that have all the specified components.
+    * @return The number of entities.
+    */
+    template<typename... T>
+    size_t countEntitiesWith() {
+        return view<T...>().size();
+    }
+
+    /**
+    * @brief Splits the archetypes that have all the specified components into chunks.
+    * @param chunkSize The maximum number of rows of each chunk.
+    * @return Vector of chunks, a chunk never spans more than one archetype.
+    */
+    template<typename... T>
+    std::vector<ArchetypeChunk> getChunks(size_t chunkSize) {
+        std::vector<ArchetypeChunk> chunks;
+        chunkSize = std::max<size_t>(chunkSize, 1);
+
+        for (auto& archetype : view<T...>().getArchetypes()) {
+            for (size_t begin = 0; begin < archetype->size(); begin += chunkSize) {
+                chunks.push_back({ archetype, begin, std::min(begin + chunkSize, archetype->size()) });
             }
         }
-        return list;
+        return chunks;
+    }
+
+    /**
+    * @brief Calls fn(entity, components...) for every row of the chunk.
+    * @param chunk The chunk to iterate.
+    * @param fn The function to call, taking an Entity pointer and a pointer to each specified component.
+    */
+    template<typename... T, typename F>
+    static void forEachInChunk(const ArchetypeChunk& chunk, F&& fn) {
+        View<T...>::forEachRow(chunk.archetype, chunk.begin, chunk.end, fn);
     }
 
     /**
-    * @brief Returns a vector of entities that have the specified tag.
+    * @brief Calls fn(entity, components...) for every entity that has all the specified components.
+    * @param fn The function to call, taking an Entity pointer and a pointer to each specified component.
+    */
+    template<typename... T, typename F>
+    void forEach(F&& fn) {
+        view<T...>().forEach(fn);
+    }
+
+    /**
+    * @brief Returns the entities whose primary tag is the specified tag.
+    *
+    * The list is maintained as tags change, so the call neither scans nor allocates.
     * @param tag The tag to search for.
-    * @return Vector of entities that have the specified tag.
+    * @return Constant reference to the vector of entities that have the specified tag.
     */
-    std::vector<Entity*> getEntitiesWithTag(Tag tag);
+    const std::vector<Entity*>& getEntitiesWithTag(Tag tag) const;
 
     /**
-    * @brief Returns a vector of entities that have the specified layer.
+    * @brief Returns the entities of the specified layer.
+    *
+    * The list is maintained as layers change, so the call neither scans nor allocates.
     * @param layer The layer to search for.
-    * @return Vector of entities that have the specified layer.
+    * @return Constant reference to the vector of entities that have the specified layer.
     */
-    std::vector<Entity*> getEntitiesWithLayer(Layer layer);
+    const std::vector<Entity*>& getEntitiesWithLayer(Layer layer) const;
 
     /**
-    * @brief Returns a vector of entities that belong to the specified group, along with their PrimitiveType or RenderType.
+    * @brief Returns the members of the specified group in the specified layer.
+    *
+    * The list is maintained as components and layers change, so the call neither scans nor allocates.
     * @param group The group to search for.
-    * @return Vector of pairs, each containing an Entity pointer and a variant of PrimitiveType or RenderType, for entities that belong to the specified group.
+    * @param layer The layer to search for.
+    * @return Constant reference to the vector of members, each with its resolved component pointers.
     */
-    std::vector<std::pair<Entity*, std::variant<PrimitiveType, RenderType>>> getEntitiesWithGroup(Group group);
+    const std::vector<GroupMember>& getGroup(Group group, Layer layer) const;
 
     /**
-    * @brief Updates the state of the EntityManager.
+    * @brief Returns the members of the specified group in all the layers.
+    * @param group The group to search for.
+    * @return Vector of members, ordered by layer.
+    */
+    std::vector<GroupMember> getEntitiesWithGroup(Group group) const;
+
+    /**
+    * @brief Updates the state of the EntityManager, playing back the recorded structural changes.
     */
     void update();
 
     /**
-    * @brief Marks the specified entity for deletion.
+    * @brief Marks the specified entity for deletion, it is removed in the next update.
     * @param entity Pointer to the entity to mark for deletion.
     */
     void killEntity(Entity* entity);
 
     /**
-    * @brief Clears all entities.
+    * @brief Returns the command buffer played back by update().
+    *
+    * Systems, including the ones running on worker threads, record creations, kills and
+    * component changes here instead of changing the archetypes while iterating them.
+    * @return Reference to the command buffer.
+    */
+    EntityCommandBuffer& getCommandBuffer();
+
+    /**
+    * @brief Clears all entities and discards the structural changes recorded but not yet played back.
     */
     void clear();
 
+    /**
+    * @brief Clears all entities and releases the entity and component pools at once.
+    *
+    * Meant for scene transitions, it is only valid when no component outlives the entities,
+    * e.g. an Animation held by an AnimationController.
+    */
+    void reset();
+
     /**
     * @brief Clears the specified entity.
     * @param entity Pointer to the entity to clear.
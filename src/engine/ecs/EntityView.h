@@ -0,0 +1,216 @@
+/**
+* @file EntityView.h
+* @author Hudson Schumaker
+* @brief Defines the EntityView and View classes.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Archetype.h"
+
+/**
+* @class EntityView
+* @brief A persistent query: the list of archetypes that have all the components of a mask.
+*
+* The EntityManager appends every new matching archetype to the view, and the archetypes
+* themselves keep their rows up to date when components are added, removed or entities
+* are killed, so iterating a view never scans the world nor allocates.
+* Adding or removing components while iterating a view moves entities between archetypes,
+* such changes must be deferred until the iteration ends.
+*/
+class EntityView final {
+private:
+    Signature mask;
+    std::vector<Archetype*> archetypes;
+
+public:
+    /**
+    * @class Iterator
+    * @brief Forward iterator over the entities of the view.
+    */
+    class Iterator final {
+    private:
+        const std::vector<Archetype*>* archetypes = nullptr;
+        size_t archetypeIndex = 0;
+        size_t row = 0;
+
+        void skipEmpty() {
+            while (archetypeIndex < archetypes->size() && row >= (*archetypes)[archetypeIndex]->size()) {
+                archetypeIndex++;
+                row = 0;
+            }
+        }
+
+    public:
+        Iterator(const std::vector<Archetype*>* archetypes, size_t archetypeIndex) : archetypes(archetypes), archetypeIndex(archetypeIndex) {
+            skipEmpty();
+        }
+
+        Entity* operator*() const {
+            return (*archetypes)[archetypeIndex]->getEntities()[row];
+        }
+
+        Iterator& operator++() {
+            row++;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return archetypeIndex == other.archetypeIndex && row == other.row;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    EntityView(const Signature& mask) : mask(mask) {}
+    ~EntityView() = default;
+
+    /**
+    * @brief Returns the component mask of the view.
+    * @return The mask.
+    */
+    const Signature& getMask() const {
+        return mask;
+    }
+
+    /**
+    * @brief Returns the archetypes that match the view.
+    * @return Constant reference to the vector of archetypes.
+    */
+    const std::vector<Archetype*>& getArchetypes() const {
+        return archetypes;
+    }
+
+    /**
+    * @brief Adds the archetype to the view if it has all the components of the mask.
+    * @param archetype Pointer to the new archetype.
+    */
+    void onArchetypeCreated(Archetype* archetype) {
+        if (archetype->hasAll(mask)) {
+            archetypes.push_back(archetype);
+        }
+    }
+
+    /**
+    * @brief Forgets all the archetypes, used when the EntityManager is cleared.
+    */
+    void clear() {
+        archetypes.clear();
+    }
+
+    /**
+    * @brief Returns the number of entities of the view.
+    * @return The number of entities.
+    */
+    size_t size() const {
+        size_t count = 0;
+        for (auto& archetype : archetypes) {
+            count += archetype->size();
+        }
+        return count;
+    }
+
+    Iterator begin() const {
+        return Iterator(&archetypes, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(&archetypes, archetypes.size());
+    }
+};
+
+/**
+* @class View
+* @brief Typed handle of an EntityView, returned by EntityManager::view<T...>().
+*/
+template<typename... T>
+class View final {
+private:
+    const EntityView* entityView = nullptr;
+
+public:
+    View(const EntityView* entityView) : entityView(entityView) {}
+    ~View() = default;
+
+    /**
+    * @brief Returns the number of entities of the view.
+    * @return The number of entities.
+    */
+    size_t size() const {
+        return entityView->size();
+    }
+
+    /**
+    * @brief Returns the archetypes that match the view.
+    * @return Constant reference to the vector of archetypes.
+    */
+    const std::vector<Archetype*>& getArchetypes() const {
+        return entityView->getArchetypes();
+    }
+
+    /**
+    * @brief Calls fn(entity, components...) for every entity of the view.
+    * @param fn The function to call, taking an Entity pointer and a pointer to each component of the view.
+    */
+    template<typename F>
+    void forEach(F&& fn) const {
+        for (auto& archetype : entityView->getArchetypes()) {
+            forEachRow(archetype, 0, archetype->size(), fn, std::index_sequence_for<T...>{});
+        }
+    }
+
+    /**
+    * @brief Calls fn(entity, components...) for the rows [begin, end) of the archetype.
+    * @param archetype Pointer to an archetype of the view.
+    * @param begin The first row.
+    * @param end One past the last row.
+    * @param fn The function to call, taking an Entity pointer and a pointer to each component of the view.
+    */
+    template<typename F>
+    static void forEachRow(const Archetype* archetype, size_t begin, size_t end, F&& fn) {
+        forEachRow(archetype, begin, end, fn, std::index_sequence_for<T...>{});
+    }
+
+    EntityView::Iterator begin() const {
+        return entityView->begin();
+    }
+
+    EntityView::Iterator end() const {
+        return entityView->end();
+    }
+
+private:
+    template<typename F, size_t... I>
+    static void forEachRow(const Archetype* archetype, size_t begin, size_t end, F& fn, std::index_sequence<I...>) {
+        Entity* const* rows = archetype->getEntities();
+
+        // Resolve the columns once per block, inside a block the inner loop only walks arrays of values
+        size_t row = begin;
+        while (row < end) {
+            size_t blockEnd = std::min(end, Archetype::getBlockEnd(row));
+            std::tuple<T*...> columns(archetype->get<T>(row)...);
+
+            for (size_t i = 0; row < blockEnd; row++, i++) {
+                fn(rows[row], (std::get<I>(columns) + i)...);
+            }
+        }
+    }
+};
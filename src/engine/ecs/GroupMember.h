@@ -0,0 +1,58 @@
+/**
+* @file GroupMember.h
+* @author Hudson Schumaker
+* @brief Defines the GroupMember struct.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "../gfx/GfxTypes.h"
+#include "../physics/PhysicsTypes.h"
+#include "component/Component.h"
+#include "component/Transform.h"
+
+class Entity;
+
+/**
+* @brief The kind of member of a group: RenderType for RENDERABLE, PrimitiveType for PRIMITIVES,
+* ColliderType for COLLIDER and std::monostate for CLICKABLE.
+*/
+using GroupType = std::variant<std::monostate, PrimitiveType, RenderType, ColliderType>;
+
+/**
+* @struct GroupMember
+* @brief An entry of a Group list of the EntityManager, with the component pointers already resolved.
+*
+* The entries are kept up to date when components are added, removed or replaced, so they
+* must not be stored across structural changes.
+*/
+struct GroupMember {
+    Entity* entity = nullptr;
+    Transform* transform = nullptr;
+    Component* component = nullptr; // The component that puts the entity in the group, e.g. its Sprite or its BoxCollider
+    GroupType type;
+
+    /**
+    * @brief Returns the component that puts the entity in the group.
+    * @return Pointer to the component, cast to the given type.
+    */
+    template<typename T>
+    T* get() const {
+        return static_cast<T*>(component);
+    }
+};
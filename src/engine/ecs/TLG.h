@@ -20,6 +20,11 @@ enum class Tag {
     UI
 };
 
+/**
+* @brief Number of values of the Tag enum.
+*/
+constexpr size_t TAG_COUNT = static_cast<size_t>(Tag::UI) + 1;
+
 /**
 * @enum Layer
 * @brief Defines the layers that can be assigned to entities in the game.
@@ -32,6 +37,11 @@ enum class Layer {
     FOREGROUND
 };
 
+/**
+* @brief Number of values of the Layer enum.
+*/
+constexpr size_t LAYER_COUNT = static_cast<size_t>(Layer::FOREGROUND) + 1;
+
 /**
 * @enum Group
 * @brief Defines the groups that can be assigned to entities in the game.
@@ -44,3 +54,8 @@ enum class Group {
     COLLIDER,
     RENDERABLE,
 };
+
+/**
+* @brief Number of values of the Group enum.
+*/
+constexpr size_t GROUP_COUNT = static_cast<size_t>(Group::RENDERABLE) + 1;
@@ -25,6 +25,9 @@
 /**
  * @class Callback
  * @brief The Callback class is a component that stores a callback function.
+ *
+ * The CollisionSystem calls it when its entity starts touching another entity, and calls the
+ * exit callback function when they stop touching.
  */
 class Callback : public Component {
 
@@ -38,6 +41,11 @@ public:
         instance = callback;
     }
 
+    Callback(const CallbackFunction& callback, const CallbackFunction& exitCallback) {
+        instance = callback;
+        exitInstance = exitCallback;
+    }
+
     ~Callback() = default;
 
     /**
@@ -51,6 +59,18 @@ public:
        }
     }
 
+    /**
+     * @brief Calls the exit callback function, when the entity stops touching the other one.
+     * @param id The id of the entity.
+     * @param otherId The id of the other entity.
+     */
+    void callExit(unsigned long id, unsigned long otherId) {
+       if (exitInstance) {
+           exitInstance(id, otherId);
+       }
+    }
+
 private:
     CallbackFunction instance;
+    CallbackFunction exitInstance;
 };
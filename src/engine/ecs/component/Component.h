@@ -21,13 +21,114 @@
 */
 #pragma once
 #include "../../../Pch.h"
+#include "../../core/SlabAllocator.h"
+
+/**
+* @brief The maximum number of component types, the width of an entity signature.
+*/
+constexpr size_t MAX_COMPONENTS = 64;
+
+/**
+* @brief One bit per component family, set when the entity has a component of that family.
+*/
+using Signature = std::bitset<MAX_COMPONENTS>;
+
+class Component;
+
+/**
+* @struct ComponentType
+* @brief What an Archetype needs to store the values of a component type it does not know.
+*/
+struct ComponentType {
+	size_t size = 0;
+	void (*relocate)(void* to, void* from) = nullptr; // Move constructs the value at to and destroys the one at from
+	void (*destroy)(void* component) = nullptr;
+	Component* (*cast)(void* component) = nullptr;
+};
 
 /**
 * @class Component
 * @brief The base class for all components.
 */
 class Component {
+private:
+	inline static std::atomic<size_t> nextFamily = 0;
+	inline static std::array<ComponentType, MAX_COMPONENTS> types;
+
+	/**
+	* @brief Assigns the next family id to the component type T and records how to store its values.
+	* @return The family id.
+	*/
+	template<typename T>
+	static size_t registerType() {
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Component types cannot be over-aligned");
+		size_t family = nextFamily++;
+		assert(family < MAX_COMPONENTS && "Too many component types, raise MAX_COMPONENTS");
+
+		ComponentType& type = types[family];
+		type.size = sizeof(T);
+		type.relocate = [](void* to, void* from) {
+			T* value = static_cast<T*>(from);
+			::new (to) T(std::move(*value));
+			value->~T();
+		};
+		type.destroy = [](void* component) {
+			static_cast<T*>(component)->~T();
+		};
+		type.cast = [](void* component) -> Component* {
+			return static_cast<T*>(component);
+		};
+		return family;
+	}
+
 public:
 	unsigned long parentId = 0;
 	virtual ~Component() {}
+
+	/**
+	* @brief Components are allocated from the ComponentAllocator pools.
+	*
+	* The destructor is virtual, so delete passes the size of the most derived type.
+	*/
+	static void* operator new(size_t size) {
+		return ComponentAllocator::allocate(size);
+	}
+
+	static void operator delete(void* block, size_t size) {
+		ComponentAllocator::deallocate(block, size);
+	}
+
+	/**
+	* @brief Returns the family id of the component type T.
+	*
+	* The id is assigned the first time the type is used and never changes afterwards,
+	* it is the index of the type in entity storage and signatures. The engine supports
+	* up to MAX_COMPONENTS component types.
+	* @return The family id.
+	*/
+	template<typename T>
+	static size_t getFamily() {
+		static const size_t family = registerType<T>();
+		return family;
+	}
+
+	/**
+	* @brief Returns how to store the values of a component family.
+	* @param family The family id, returned by getFamily().
+	* @return Constant reference to the type.
+	*/
+	static const ComponentType& getType(size_t family) {
+		return types[family];
+	}
+
+	/**
+	* @brief Returns the signature that has the bits of all the specified component types set.
+	* @return The signature of the component types.
+	*/
+	template<typename... T>
+	static Signature getSignature() {
+		Signature signature;
+		(signature.set(getFamily<T>()), ...);
+		return signature;
+	}
 };
@@ -27,11 +27,15 @@
 /**
  * @class Radar
  * @brief The Radar class is a component that allows to detect other entities within a certain radius.
+ *
+ * The RadarSystem calls onDetect once when a target enters the radius and onLeave once when it
+ * leaves, not on every frame in between.
  */
 class Radar final : public Component {
 public:
     typedef std::function<void(unsigned long, unsigned long)> OnDetectFunction;
     short r = 2; // radius
+    float hysteresis = 0.0f; // a detected target is only lost beyond r + hysteresis
     Tag tag = Tag::ENEMY;
     Vec2 offset;
 
@@ -65,12 +69,23 @@ public:
         this->callback = onDetect;
     }
 
+    void setOnLeave(const OnDetectFunction& onLeave) {
+        this->leaveCallback = onLeave;
+    }
+
     void onDetect(unsigned long radar, unsigned long target) {
         if (callback) {
             callback(radar, target);
         }
     }
 
+    void onLeave(unsigned long radar, unsigned long target) {
+        if (leaveCallback) {
+            leaveCallback(radar, target);
+        }
+    }
+
 private:
     OnDetectFunction callback = nullptr;
+    OnDetectFunction leaveCallback = nullptr;
 };
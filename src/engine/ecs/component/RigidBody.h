@@ -39,7 +39,12 @@ public:
     Vec2 velocity;
     float mass = 1.0f;
     float invMass = 1.0f;
+    float restitution = 0.5f; // Bounciness of the collisions, 0 absorbs the impact and 1 keeps all the speed
     bool isMoving = true;
+    bool isBullet = false;    // Small and fast, collisions are swept along its movement, always true for Tag::BULLET entities
+    bool canSleep = true;
+    bool isSleeping = false;  // Set by the IslandManager for resting bodies, cleared on contact
+    int stillFrames = 0;      // Consecutive frames below the sleep velocity
 
     RigidBody() = default;
     RigidBody(float x, float y) {
@@ -66,4 +71,20 @@ public:
     }
 
     ~RigidBody() = default;
+
+    /**
+    * @brief Wakes the body, to call after changing the velocity of a sleeping body by hand.
+    */
+    void wake() {
+        isSleeping = false;
+        stillFrames = 0;
+    }
+
+    /**
+    * @brief Puts the body to sleep, it stops moving until woken.
+    */
+    void sleep() {
+        isSleeping = true;
+        velocity = Vec2::zero();
+    }
 };
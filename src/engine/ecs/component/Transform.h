@@ -30,6 +30,7 @@
 class Transform final : public Component {
 public:
     Vec2 position;
+    Vec2 previousPosition; // Position before the last movement step or at the last collision update, the start of the sweep of continuous collisions
     Vec2 scale;
     double rotation;
 
@@ -44,6 +45,7 @@ public:
         this->scale.y = 1.0f;
         this->position.x = v;
         this->position.y = v;
+        this->previousPosition = this->position;
         this->rotation = 0.0;
     }
 
@@ -51,6 +53,7 @@ public:
         this->scale.x = 1.0f;
         this->scale.y = 1.0f;
         this->position = position;
+        this->previousPosition = position;
         this->rotation = 0.0f;
     }
 
@@ -59,11 +62,13 @@ public:
         this->scale.y = 1.0f;
         this->position.x = x;
         this->position.y = y;
+        this->previousPosition = this->position;
         this->rotation = 0.0f;
     }
 
     Transform(Vec2 position, Vec2 scale, double rotation = 0.0) {
         this->position = position;
+        this->previousPosition = position;
         this->scale = scale;
         this->rotation = rotation;
     }
@@ -22,34 +22,131 @@
 #pragma once
 #include "Component.h"
 #include "../../math/Vec2.h"
+#include "../../math/WaypointPath.h"
+#include "../../math/SplinePath.h"
 
 /**
 * @class Waypoint
 * @brief A class that represents a waypoint in a game.
+*
+* The points are held by a shared WaypointPath, the component only keeps the index of the
+* next point, so reaching a point is O(1) and many entities may follow the same path.
+* Alternatively the entity follows a shared SplinePath at a constant speed, its position being
+* read from the path at the distance travelled since it started.
 */
 class Waypoint final : public Component {
+private:
+	/**
+	* @property ownPath The path built point by point with addPoint(), the same object as path.
+	*/
+	std::shared_ptr<WaypointPath> ownPath;
+
 public:
 	Vec2 direction;
 
 	/**
-	* @property waypoints A vector of tuples. Each tuple represents a waypoint and contains:
-	* - A pair of shorts representing the point (x, y)
+	* @property path The path to follow, shared with the other entities that follow it.
+	*/
+	std::shared_ptr<const WaypointPath> path;
+
+	/**
+	* @property cursor The index of the next point of the path.
+	*/
+	size_t cursor = 0;
+
+	/**
+	* @property spline The spline to follow instead of the path, shared with the other entities that follow it.
+	*/
+	std::shared_ptr<const SplinePath> spline;
+
+	/**
+	* @property speed The speed along the spline, in pixels per second.
+	*/
+	float speed = 0.0f;
+
+	/**
+	* @property elapsed The time since the entity started the spline, or the current lap when looping, in seconds, negative to start later.
+	*/
+	float elapsed = 0.0f;
+
+	/**
+	* @property offset Added to the points of the spline, e.g. the place of the entity in a formation.
+	*/
+	Vec2 offset;
+
+	/**
+	* @property isLooping Starts the spline again when its end is reached.
 	*/
-	std::vector<std::pair<short, short>> waypoints;
+	bool isLooping = false;
+
+	Waypoint(const std::shared_ptr<const WaypointPath>& path) {
+		this->path = path;
+	}
+
+	Waypoint(const std::shared_ptr<const SplinePath>& spline, float speed, Vec2 offset = Vec2()) {
+		this->spline = spline;
+		this->speed = speed;
+		this->offset = offset;
+	}
 
 	Waypoint(std::pair<short, short> point) {
-		this->waypoints.push_back(point);
+		addPoint(point);
 	}
 
 	/**
 	* add a Point that takes a pair of shorts representing a point (x, y).
+	* The point is appended in place while the component is the only owner of its path, the path
+	* is copied once if it is shared. Paths followed by many entities are better built once with
+	* AssetManager::addPath().
 	* @param point A pair of shorts representing the point
 	*/
 	void addPoint(std::pair<short, short> point) {
-		waypoints.push_back(point);
+		// Shared by someone else, e.g. a copy of path was taken, so it must not change any more
+		if (!ownPath || ownPath != path || path.use_count() > 2) {
+			ownPath = std::make_shared<WaypointPath>(path ? path->getPoints() : std::vector<Vec2>());
+			path = ownPath;
+		}
+		ownPath->addPoint(Vec2(static_cast<float>(point.first), static_cast<float>(point.second)));
 	}
-	
-	~Waypoint() {
-		this->waypoints.clear();
+
+	/**
+	* @brief Checks if every point of the path, or the end of the spline, was reached.
+	* @return True if there is no next point, false otherwise.
+	*/
+	bool isFinished() const {
+		if (spline) {
+			return !isLooping && getDistance() >= spline->getLength();
+		}
+		return !path || cursor >= path->size();
 	}
+
+	/**
+	* @brief Returns the distance travelled along the spline.
+	* @return The distance, wrapped to the length of the spline when looping.
+	*/
+	float getDistance() const {
+		float distance = std::max(elapsed, 0.0f) * speed;
+		if (isLooping && spline && spline->getLength() > 0.0f) {
+			distance = std::fmod(distance, spline->getLength());
+		}
+		return distance;
+	}
+
+	/**
+	* @brief Returns the next point of the path.
+	* @return Constant reference to the point, the path must not be finished.
+	*/
+	const Vec2& getTarget() const {
+		return path->getPoint(cursor);
+	}
+
+	/**
+	* @brief Moves to the next point of the path.
+	*/
+	void advance() {
+		cursor++;
+		direction = Vec2::zero();
+	}
+
+	~Waypoint() = default;
 };
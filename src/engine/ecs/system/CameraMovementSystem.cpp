@@ -23,14 +23,16 @@
 #include "../component/Transform.h"
 #include "../component/CameraFollow.h"
 
-void CameraMovementSystem::update(Map* map, Camera* camera) {
-    // Get all entities with CameraFollow components
-	auto entities = EntityManager::getInstance()->getEntitiesWithComponent<CameraFollow>();
+CameraMovementSystem::CameraMovementSystem() {
+	reads<CameraFollow, Transform>();
 
-    // For each entity with CameraFollow component
-	for (auto& entity : entities) {
-        Transform* transform = entity->getComponent<Transform>(); // Get the Transform component 
+	// The camera is shared with the render systems
+	runOnMainThread();
+}
 
+void CameraMovementSystem::update(Map* map, Camera* camera) {
+    // For each entity with CameraFollow and Transform components
+	EntityManager::getInstance()->view<CameraFollow, Transform>().forEach([map, camera](Entity* entity, CameraFollow* follow, Transform* transform) {
         // calculate
 		if (transform->position.x + (camera->w / 2) < map->mapWidth) {
 			camera->x = int(transform->position.x - Defs::SCREEN_H_WIDTH);
@@ -49,5 +51,5 @@ void CameraMovementSystem::update(Map* map, Camera* camera) {
 			
 		camera->y = (camera->y + camera->h > map->mapHeight) ?
 			map->mapHeight - camera->h : camera->y;
-	}
+	});
 }
@@ -26,7 +26,7 @@
 
 class CameraMovementSystem : public System {
 public:
-	CameraMovementSystem() = default;
+	CameraMovementSystem();
 	~CameraMovementSystem() = default;
 
 	void update(Map* map, Camera* camera);
@@ -0,0 +1,288 @@
+/**
+* @file CollisionSystem.cpp
+* @author Hudson Schumaker
+* @brief Implements the CollisionSystem class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "CollisionSystem.h"
+#include "../Entity.h"
+#include "../EntityManager.h"
+#include "../../event/EventBus.h"
+#include "../component/Callback.h"
+#include "../component/RigidBody.h"
+#include "../component/BoxCollider.h"
+#include "../component/CircleCollider.h"
+#include "../../physics/Narrowphase.h"
+#include "../../physics/SpatialHashBroadphase.h"
+#include "../../physics/DynamicTreeBroadphase.h"
+#include "../../physics/SweepAndPruneBroadphase.h"
+
+CollisionSystem::CollisionSystem() {
+	broadphase = std::make_unique<SpatialHashBroadphase>();
+	reads<BoxCollider, CircleCollider>();
+	writes<Transform, RigidBody>();
+}
+
+void CollisionSystem::setBroadphase(std::unique_ptr<Broadphase> broadphase) {
+	this->broadphase = std::move(broadphase);
+}
+
+void CollisionSystem::setBroadphase(BroadphaseType type) {
+	switch (type) {
+	case BroadphaseType::DYNAMIC_TREE:
+		broadphase = std::make_unique<DynamicTreeBroadphase>();
+		break;
+	case BroadphaseType::SWEEP_AND_PRUNE:
+		broadphase = std::make_unique<SweepAndPruneBroadphase>();
+		break;
+	default:
+		broadphase = std::make_unique<SpatialHashBroadphase>();
+		break;
+	}
+}
+
+void CollisionSystem::setSolverIterations(int iterations) {
+	solver.setIterations(iterations);
+}
+
+const std::vector<Collision>& CollisionSystem::getContacts() const {
+	return contacts;
+}
+
+void CollisionSystem::setSleepThreshold(float velocity, int frames) {
+	islandManager.setSleepThreshold(velocity, frames);
+}
+
+CollisionMatrix& CollisionSystem::getCollisionMatrix() {
+	return collisionMatrix;
+}
+
+const ContactCache& CollisionSystem::getContactCache() const {
+	return contactCache;
+}
+
+PhysicsQuery CollisionSystem::getQuery() const {
+	return PhysicsQuery(broadphase.get(), &proxies);
+}
+
+void CollisionSystem::update() {
+	detect();
+	sweepBullets();
+	resolve();
+	contactCache.update(contacts);
+	islandManager.update(proxies, contacts, restingPairs);
+
+	// The next sweep starts where the collider ends this frame, also when game code moves it instead of a system
+	for (auto& proxy : proxies) {
+		proxy.transform->previousPosition = proxy.transform->position;
+	}
+}
+
+void CollisionSystem::dispatchEvents() {
+	EntityManager* entityManager = EntityManager::getInstance();
+	EventBus* eventBus = EventBus::getInstance();
+
+	// The entities are looked up on every call, a callback may remove the other entity
+	auto notify = [entityManager](unsigned long id, unsigned long otherId, ContactPhase phase) {
+		Entity* entity = entityManager->getEntity(id);
+		Callback* callback = entity ? entity->getComponent<Callback>() : nullptr;
+		if (callback == nullptr) {
+			return;
+		}
+
+		if (phase == ContactPhase::ENTER) {
+			callback->call(id, otherId);
+		}
+		else {
+			callback->callExit(id, otherId);
+		}
+	};
+
+	for (const auto& transition : contactCache.getTransitions()) {
+		notify(transition.a, transition.b, transition.phase);
+		notify(transition.b, transition.a, transition.phase);
+		eventBus->emitEvent<CollisionEvent>(transition.a, transition.b, transition.phase);
+	}
+}
+
+void CollisionSystem::detect() {
+	contacts.clear();
+	pairs.clear();
+
+	// Broadphase: the pairs of colliders whose bounds overlap
+	Broadphase::collectProxies(proxies, collisionMatrix);
+	broadphase->update(proxies);
+	broadphase->findPairs(pairs);
+
+	// Resting pairs with a sleeping body cannot have changed, the ones that touched keep touching without the narrowphase
+	restingPairs.clear();
+	size_t activePairs = 0;
+	for (const auto& pair : pairs) {
+		const ColliderProxy& a = proxies[pair.a];
+		const ColliderProxy& b = proxies[pair.b];
+		if (!a.isResting() || !b.isResting() || (!a.isSleeping() && !b.isSleeping())) {
+			pairs[activePairs++] = pair;
+		}
+		else if (contactCache.isTouching(a.entity->id, b.entity->id)) {
+			contactCache.keep(a.entity->id, b.entity->id);
+			restingPairs.push_back(pair);
+		}
+	}
+	pairs.resize(activePairs);
+
+	// Narrowphase: each range of pairs writes to its own buffer
+	size_t rangeCount = getRangeCount(pairs.size());
+	if (rangeContacts.size() < rangeCount) {
+		rangeContacts.resize(rangeCount);
+	}
+
+	parallelForRanges(pairs.size(), [this](size_t range, size_t begin, size_t end) {
+		auto& buffer = rangeContacts[range];
+		buffer.clear();
+
+		Collision collision;
+		for (size_t i = begin; i < end; i++) {
+			if (Narrowphase::collide(proxies[pairs[i].a], proxies[pairs[i].b], collision)) {
+				buffer.push_back(collision);
+			}
+		}
+	});
+
+	// Merge the buffers in range order
+	for (size_t range = 0; range < rangeCount; range++) {
+		contacts.insert(contacts.end(), rangeContacts[range].begin(), rangeContacts[range].end());
+	}
+}
+
+bool CollisionSystem::isBullet(const ColliderProxy& proxy) {
+	if (proxy.entity->getTag() == Tag::BULLET) {
+		return true;
+	}
+
+	return proxy.rigidBody && proxy.rigidBody->isBullet;
+}
+
+void CollisionSystem::sweepBullets() {
+	sweptContacts.clear();
+	sweptEntities.clear();
+
+	for (size_t i = 0; i < proxies.size(); i++) {
+		const ColliderProxy& bullet = proxies[i];
+		if (!isBullet(bullet)) {
+			continue;
+		}
+
+		// Slow bullets cannot skip over anything, the discrete test is enough
+		Transform* transform = bullet.transform;
+		Vec2 movement = transform->position - transform->previousPosition;
+		Vec2 halfSize((bullet.bounds.max.x - bullet.bounds.min.x) * 0.5f, (bullet.bounds.max.y - bullet.bounds.min.y) * 0.5f);
+		if (std::fabs(movement.x) <= halfSize.x && std::fabs(movement.y) <= halfSize.y) {
+			continue;
+		}
+
+		// Only the colliders in the cells covered by the sweep are candidates
+		AABB startBounds(bullet.bounds.min - movement, bullet.bounds.max - movement);
+		candidates.clear();
+		broadphase->query(bullet.bounds.merge(startBounds), candidates);
+
+		Vec2 start = startBounds.center();
+		float earliest = 1.0f;
+		size_t target = i;
+		Vec2 targetNormal;
+
+		for (size_t candidate : candidates) {
+			const ColliderProxy& other = proxies[candidate];
+			if (other.entity == bullet.entity || !bullet.canCollide(other)) {
+				continue;
+			}
+
+			// Sweep the center of the bullet against the target grown by the size of the bullet
+			float time = 1.0f;
+			Vec2 normal;
+			bool isHit = false;
+			if (bullet.type == ColliderType::CIRCLE && other.type == ColliderType::CIRCLE) {
+				float radius = halfSize.x + (other.bounds.max.x - other.bounds.min.x) * 0.5f;
+				isHit = Narrowphase::rayCircle(start, movement, other.bounds.center(), radius, time, normal);
+			}
+			else if (bullet.type == ColliderType::CIRCLE) {
+				isHit = Narrowphase::rayBox(start, movement, other.bounds.expand(halfSize.x), time, normal);
+			}
+			else {
+				AABB grown(other.bounds.min - halfSize, other.bounds.max + halfSize);
+				isHit = Narrowphase::rayBox(start, movement, grown, time, normal);
+			}
+
+			if (isHit && time < earliest) {
+				earliest = time;
+				target = candidate;
+				targetNormal = normal;
+			}
+		}
+
+		if (target == i) {
+			continue;
+		}
+
+		// Move the bullet back to the point of impact
+		transform->position = transform->previousPosition + movement * earliest;
+
+		const ColliderProxy& other = proxies[target];
+		Vec2 center = start + movement * earliest;
+		Collision collision;
+		collision.eA = bullet.entity;
+		collision.eB = other.entity;
+		collision.tA = bullet.transform;
+		collision.tB = other.transform;
+		collision.rA = bullet.rigidBody;
+		collision.rB = other.rigidBody;
+		collision.cA = bullet.type == ColliderType::CIRCLE ? static_cast<CircleCollider*>(bullet.collider) : nullptr;
+		collision.bA = bullet.type == ColliderType::BOX ? static_cast<BoxCollider*>(bullet.collider) : nullptr;
+		collision.cB = other.type == ColliderType::CIRCLE ? static_cast<CircleCollider*>(other.collider) : nullptr;
+		collision.bB = other.type == ColliderType::BOX ? static_cast<BoxCollider*>(other.collider) : nullptr;
+		collision.normal = targetNormal * -1.0f;
+		collision.depth = 0.0f;
+		collision.start = Vec2(center.x + collision.normal.x * halfSize.x, center.y + collision.normal.y * halfSize.y);
+		collision.end = collision.start;
+
+		sweptContacts.push_back(collision);
+		sweptEntities.push_back(bullet.entity);
+	}
+
+	if (sweptContacts.empty()) {
+		return;
+	}
+
+	// The discrete contacts of the moved bullets are stale, the swept ones replace them
+	std::sort(sweptEntities.begin(), sweptEntities.end());
+	auto isSwept = [this](const Collision& contact) {
+		return std::binary_search(sweptEntities.begin(), sweptEntities.end(), contact.eA) ||
+			std::binary_search(sweptEntities.begin(), sweptEntities.end(), contact.eB);
+	};
+	contacts.erase(std::remove_if(contacts.begin(), contacts.end(), isSwept), contacts.end());
+	contacts.insert(contacts.end(), sweptContacts.begin(), sweptContacts.end());
+}
+
+void CollisionSystem::resolve() {
+	// Positional correction
+	for (auto& contact : contacts) {
+		contact.resolvePenetration();
+	}
+
+	// Velocity impulses, in batched passes over all the contacts
+	solver.solve(contacts);
+}
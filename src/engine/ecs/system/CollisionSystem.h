@@ -0,0 +1,158 @@
+/**
+* @file CollisionSystem.h
+* @author Hudson Schumaker
+* @brief Defines the CollisionSystem class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "System.h"
+#include "../../physics/Collision.h"
+#include "../../physics/Broadphase.h"
+#include "../../physics/ContactSolver.h"
+#include "../../physics/ContactCache.h"
+#include "../../physics/IslandManager.h"
+#include "../../physics/PhysicsQuery.h"
+
+/**
+* @class CollisionSystem
+* @brief Finds the contacts between the colliders and separates the bodies that overlap.
+*
+* Each frame the proxies of the COLLIDER group are indexed by the broadphase, which drops the
+* pairs whose tags do not collide in the CollisionMatrix. The remaining pairs are tested by the
+* narrowphase in parallel ranges, each range writing to its own contact buffer, and the buffers
+* are concatenated in range order, so the contacts are the same on every run.
+* Bullets are also swept from their previous position through the broadphase, so they do not
+* tunnel through thin colliders. The overlaps are then corrected and the velocities solved by
+* the ContactSolver. The ContactCache records which pairs started or stopped touching, those
+* transitions are dispatched later on the main thread by dispatchEvents().
+* Finally the IslandManager puts the settled bodies to sleep. Pairs of resting colliders skip
+* the narrowphase and keep the contact state of the previous frame, so sleeping piles cost
+* almost nothing until something moving touches them.
+*/
+class CollisionSystem final : public System {
+private:
+    std::unique_ptr<Broadphase> broadphase;
+    std::vector<ColliderProxy> proxies;
+    std::vector<BroadphasePair> pairs;
+    std::vector<BroadphasePair> restingPairs;
+    std::vector<std::vector<Collision>> rangeContacts;
+    std::vector<Collision> contacts;
+    std::vector<size_t> candidates;
+    std::vector<Collision> sweptContacts;
+    std::vector<Entity*> sweptEntities;
+    ContactSolver solver;
+    ContactCache contactCache;
+    CollisionMatrix collisionMatrix;
+    IslandManager islandManager;
+
+    /**
+    * @brief Runs the broadphase and the narrowphase, filling the contacts.
+    */
+    void detect();
+
+    /**
+    * @brief Sweeps the bullets from their previous position, moving back the ones that hit something to the point of impact.
+    *
+    * The contacts of a bullet that was moved back are replaced by the contact at the impact, so
+    * a bullet that crossed a collider within a frame still collides with it.
+    */
+    void sweepBullets();
+
+    /**
+    * @brief Checks if a collider needs continuous collision detection.
+    * @param proxy The proxy of the collider.
+    * @return True if the entity is tagged Tag::BULLET or its RigidBody is flagged as bullet, false otherwise.
+    */
+    static bool isBullet(const ColliderProxy& proxy);
+
+    /**
+    * @brief Separates the bodies of the contacts and bounces their velocities apart.
+    */
+    void resolve();
+
+public:
+    CollisionSystem();
+    ~CollisionSystem() = default;
+
+    /**
+    * @brief Replaces the broadphase, a SpatialHashBroadphase by default.
+    * @param broadphase The new broadphase.
+    */
+    void setBroadphase(std::unique_ptr<Broadphase> broadphase);
+
+    /**
+    * @brief Replaces the broadphase by one of the built in ones with its default settings.
+    *
+    * The spatial hash suits evenly sized colliders, the dynamic tree suits levels that mix
+    * very large and very small colliders, and the sweep and prune suits colliders that keep
+    * their order on the y axis from frame to frame. Benchmark them when in doubt.
+    * @param type The type of the new broadphase.
+    */
+    void setBroadphase(BroadphaseType type);
+
+    /**
+    * @brief Sets the number of passes of the contact solver.
+    * @param iterations The number of passes, 8 by default.
+    */
+    void setSolverIterations(int iterations);
+
+    /**
+    * @brief Sets when the bodies fall asleep.
+    * @param velocity The velocity under which a body is still, 5 pixels per second by default.
+    * @param frames The number of still frames before a group of touching bodies sleeps, 30 by default.
+    */
+    void setSleepThreshold(float velocity, int frames);
+
+    /**
+    * @brief Returns the matrix of the tags that collide, to configure it, e.g. ignore(Tag::UI).
+    * @return Reference to the collision matrix, every tag collides with every tag by default.
+    */
+    CollisionMatrix& getCollisionMatrix();
+
+    /**
+    * @brief Returns the contacts found by the last update.
+    * @return Constant reference to the vector of contacts.
+    */
+    const std::vector<Collision>& getContacts() const;
+
+    /**
+    * @brief Returns the pairs of entities in contact and the transitions of the last update.
+    * @return Constant reference to the contact cache.
+    */
+    const ContactCache& getContactCache() const;
+
+    /**
+    * @brief Returns the raycast and overlap queries over the colliders of the last update.
+    * @return The queries, valid until the next update or broadphase change.
+    */
+    PhysicsQuery getQuery() const;
+
+    /**
+    * @brief Calls the Callback components and emits a CollisionEvent for the transitions of the last update.
+    *
+    * Both entities of a pair that started touching get their Callback called, and their exit
+    * callback when they stop touching, if they are still alive. Must run on the main thread,
+    * after the systems of the frame, since the callbacks may change the entities.
+    */
+    void dispatchEvents();
+
+    /**
+    * @brief Finds the contacts of the frame and separates the bodies that overlap.
+    */
+    void update();
+};
@@ -33,7 +33,7 @@ void GuiUpdateSystem::subscribeToEvents() {
 }
 
 void GuiUpdateSystem::onHover(MouseHoverEvent& event) {
-	if (event.b->tags.first == Tag::UI) {
+	if (event.b->getTag() == Tag::UI) {
 		Clickable* clickable = event.b->getComponent<Clickable>();
 		if (clickable) {
 			if (event.isInside) {
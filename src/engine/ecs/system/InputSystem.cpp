@@ -26,6 +26,13 @@
 #include "../component/Transform.h"
 #include "../component/BoxCollider.h"
 
+InputSystem::InputSystem() {
+    reads<Clickable, BoxCollider, Transform>();
+
+    // SDL events can only be polled on the main thread
+    runOnMainThread();
+}
+
 void InputSystem::update() {
     SDL_Event sdlEvent;
     while (SDL_PollEvent(&sdlEvent)) {
@@ -49,8 +56,6 @@ void InputSystem::update() {
 }
 
 void InputSystem::handleMouseInput(const SDL_Event& sdlEvent) {
-    auto entities = EntityManager::getInstance()->getEntitiesWithComponent<Clickable>();
-
     // Update the mouse pointer position based on the event type
     if (sdlEvent.type == SDL_MOUSEMOTION) {
         pointer.x = sdlEvent.motion.x;
@@ -60,37 +65,44 @@ void InputSystem::handleMouseInput(const SDL_Event& sdlEvent) {
         pointer.y = sdlEvent.button.y;
     }
 
-	for (auto& entity : entities) {
-        auto components = entity->getComponents<Clickable, BoxCollider, Transform>();
-        Clickable* clickable = std::get<0>(components); // Get the Clickable component
-        BoxCollider* collider = std::get<1>(components);// Get the BoxCollider component
-        Transform* transform = std::get<2>(components); // Get the Transform component
-
-        if (collider) {
-            SDL_Rect box = { 
-                static_cast<int>(transform->position.x), 
-                static_cast<int>(transform->position.y),
-                collider->bounds.w, 
-                collider->bounds.h 
-            };
-
-            bool isHovering = isInside(pointer.getBounds(), box);
-            EventBus::getInstance()->emitEventAsync<MouseHoverEvent>(entity, isHovering);
-
-            if (isHovering) {
-                if (sdlEvent.button.button == SDL_BUTTON_LEFT) {
-                    clickable->onClick(entity->id, static_cast<int>(MouseButton::LEFT));
-                    continue;
-                }
-                if (sdlEvent.button.button == SDL_BUTTON_RIGHT) {
-                    clickable->onClick(entity->id, static_cast<int>(MouseButton::RIGHT));
-                    continue;
-                }
-                if (sdlEvent.button.button == SDL_BUTTON_MIDDLE) {
-                    clickable->onClick(entity->id, static_cast<int>(MouseButton::MIDDLE));
-                }
+    // The callbacks may add or remove components, which moves the rows of the view,
+    // so the clicked entities are collected first and called after the walk
+    std::vector<std::pair<unsigned long, MouseButton>> clicks;
+
+    // For each entity with Clickable, BoxCollider and Transform components
+    EntityManager::getInstance()->view<Clickable, BoxCollider, Transform>().forEach([this, &sdlEvent, &clicks](Entity* entity, Clickable* clickable, BoxCollider* collider, Transform* transform) {
+        SDL_Rect box = { 
+            static_cast<int>(transform->position.x), 
+            static_cast<int>(transform->position.y),
+            collider->bounds.w, 
+            collider->bounds.h 
+        };
+
+        bool isHovering = isInside(pointer.getBounds(), box);
+        EventBus::getInstance()->emitEventAsync<MouseHoverEvent>(entity, isHovering);
+
+        if (isHovering) {
+            if (sdlEvent.button.button == SDL_BUTTON_LEFT) {
+                clicks.emplace_back(entity->id, MouseButton::LEFT);
+                return;
+            }
+            if (sdlEvent.button.button == SDL_BUTTON_RIGHT) {
+                clicks.emplace_back(entity->id, MouseButton::RIGHT);
+                return;
+            }
+            if (sdlEvent.button.button == SDL_BUTTON_MIDDLE) {
+                clicks.emplace_back(entity->id, MouseButton::MIDDLE);
             }
         }
+    });
+
+    for (auto& [id, button] : clicks) {
+        // An earlier callback may have removed the entity or its Clickable
+        Entity* entity = EntityManager::getInstance()->getEntity(id);
+        Clickable* clickable = entity ? entity->getComponent<Clickable>() : nullptr;
+        if (clickable) {
+            clickable->onClick(id, static_cast<int>(button));
+        }
     }
 }
 
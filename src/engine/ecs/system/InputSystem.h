@@ -31,7 +31,7 @@
  */
 class InputSystem final : public System {
 public:
-    InputSystem() = default;
+    InputSystem();
     ~InputSystem() = default;
 
     void update();
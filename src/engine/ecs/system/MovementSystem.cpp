@@ -24,39 +24,32 @@
 #include "../component/Transform.h"
 #include "../component/RigidBody.h"
 
-void MovementSystem::update(float dt) {
-    // Get all entities with RigidBody components
-    auto chunks = calculateChunksAndThreads<RigidBody>();
+MovementSystem::MovementSystem() {
+	reads<RigidBody, Waypoint>();
+	writes<Transform>();
+}
 
-    // Vector to hold the threads
-    std::vector<std::thread> threads;
+void MovementSystem::update(float dt) {
+    // Get the chunks of the archetypes with RigidBody and Transform components
+    auto chunks = calculateChunksAndThreads<RigidBody, Transform>();
 
-    // For each chunk of entities, create a thread
-    for (const auto& chunk : chunks) {
-        threads.emplace_back([chunk, dt] {
-            // For each entity in the chunk
-            for (auto& entity : chunk) {
-                // Do nothing if the entity have a Waypoint component
-                if (entity->getComponent<Waypoint>()) {
-					continue;
-				}
+    // Process each chunk of entities on the worker threads
+    parallelForChunks(chunks, [dt](const ArchetypeChunk& chunk) {
+        // Do nothing if the entities have a Waypoint component
+        if (chunk.archetype->has<Waypoint>()) {
+            return;
+        }
 
-                auto components = entity->getComponents<RigidBody, Transform>();
-                RigidBody* rigidBody = std::get<0>(components); // Get the RigidBody component
-                Transform* transform = std::get<1>(components); // Get the Transform component
+        // For each entity in the chunk
+        EntityManager::forEachInChunk<RigidBody, Transform>(chunk, [dt](Entity* entity, RigidBody* rigidBody, Transform* transform) {
+            transform->previousPosition = transform->position;
 
-                // If the entity is not moving ignore it
-                if (!rigidBody->isMoving) { continue; }
+            // If the entity is not moving or asleep ignore it
+            if (!rigidBody->isMoving || rigidBody->isSleeping) { return; }
 
-                // Update the position based on the velocity
-                transform->position.x += rigidBody->velocity.x * dt;
-				transform->position.y += rigidBody->velocity.y * dt;
-            }
+            // Update the position based on the velocity
+            transform->position.x += rigidBody->velocity.x * dt;
+            transform->position.y += rigidBody->velocity.y * dt;
         });
-    }
-
-    // Wait for all threads to finish
-    for (auto& thread : threads) {
-        thread.join();
-    }
+    });
 }
@@ -28,7 +28,7 @@
  */
 class MovementSystem final : public System {
 public:
-	MovementSystem() = default;
+	MovementSystem();
 	~MovementSystem() = default;
 
 	void update(float dt);
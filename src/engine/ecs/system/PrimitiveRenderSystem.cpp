@@ -24,36 +24,23 @@
 #include "../../gfx/Gfx.h"
 #include "../../gfx/Line.h"
 #include "../../gfx/Circle.h"
+#include "../../core/JobSystem.h"
 
 PrimitiveRenderSystem::PrimitiveRenderSystem() {
 	this->renderer = Gfx::getInstance()->getRenderer();
+	reads<Line, Box, Circle, Transform>();
+	runOnMainThread();
 }
 
 void PrimitiveRenderSystem::update(const Camera* camera) {
-	primitives_t primitives;
 	primitives_t background;
 	primitives_t middleground;
 	primitives_t foreground;
 
-	getPrimitives(&primitives);
-
-	// Filter primitives by Layer
-	for (auto& primitive : primitives) {
-		auto entity = std::get<0>(primitive);
-		if (entity->layer == Layer::BACKGROUND) {
-			background.push_back(primitive);
-			continue;
-		}
-		
-		if (entity->layer == Layer::MIDDLEGROUND) {
-			middleground.push_back(primitive);
-			continue;
-		}
-		
-		if (entity->layer == Layer::FOREGROUND) {
-			foreground.push_back(primitive);
-		}
-	}	
+	// Collect the primitives of each Layer from the PRIMITIVES group
+	getPrimitives(Layer::BACKGROUND, &background);
+	getPrimitives(Layer::MIDDLEGROUND, &middleground);
+	getPrimitives(Layer::FOREGROUND, &foreground);
 
 	// Sort primitives
 	sortPrimitives(&background, &middleground, &foreground);
@@ -71,47 +58,40 @@ void PrimitiveRenderSystem::update(const Camera* camera) {
 	}
 }
 
-void PrimitiveRenderSystem::getPrimitives(primitives_t* primitives) {
-	auto primitivesEntities = EntityManager::getInstance()->getEntitiesWithGroup(Group::PRIMITIVES);
-
-	for (auto& pair : primitivesEntities) {
-		Entity* entity = pair.first;
-		PrimitiveType type = std::get<PrimitiveType>(pair.second);
-		primitives->push_back(
-			std::make_tuple(	
-				entity,
-				entity->getComponent<Transform>(),
-				type
-			)
-		);
+void PrimitiveRenderSystem::getPrimitives(Layer layer, primitives_t* primitives) {
+	const auto& members = EntityManager::getInstance()->getGroup(Group::PRIMITIVES, layer);
+	primitives->reserve(members.size());
+
+	for (auto& member : members) {
+		primitives->push_back(std::make_tuple(member.entity, member.transform, std::get<PrimitiveType>(member.type)));
 	}
 }
 
 void PrimitiveRenderSystem::sortPrimitives(primitives_t* background, primitives_t* middleground, primitives_t* foreground) {
-	auto bgFuture = std::async(std::launch::async, [&]() {
+	JobCounter counter{ 0 };
+
+	// Sort the background and middleground layers on the workers
+	JobSystem::getInstance()->submit([&]() {
 		std::sort(background->begin(), background->end(), [](const auto& a, const auto& b) {
 			return std::get<0>(a)->zIndex < std::get<0>(b)->zIndex;
 		});
-	});
+	}, counter);
 
-	auto mdFuture = std::async(std::launch::async, [&]() {
+	JobSystem::getInstance()->submit([&]() {
 		std::sort(middleground->begin(), middleground->end(), [](const auto& a, const auto& b) {
 			Transform* transformA = std::get<1>(a);
 			Transform* transformB = std::get<1>(b);
 			return transformA->position.y < transformB->position.y;
 		});
-	});
+	}, counter);
 
-	auto fgFuture = std::async(std::launch::async, [&]() {
-		std::sort(foreground->begin(), foreground->end(), [](const auto& a, const auto& b) {
-			return std::get<0>(a)->zIndex < std::get<0>(b)->zIndex;
-		});
+	// Sort the foreground layer on the calling thread
+	std::sort(foreground->begin(), foreground->end(), [](const auto& a, const auto& b) {
+		return std::get<0>(a)->zIndex < std::get<0>(b)->zIndex;
 	});
 
-	// Wait for all futures to complete
-	bgFuture.get();
-	mdFuture.get();
-	fgFuture.get();
+	// Wait for the other layers, helping the workers meanwhile
+	JobSystem::getInstance()->wait(counter);
 }
 
 void PrimitiveRenderSystem::renderLine(primitive_t& primitive, const Camera* camera) {
@@ -40,12 +40,13 @@ private:
 	SDL_Renderer* renderer = nullptr;
 
 	/**
-	* @brief Collects all the primitives in the game.
+	* @brief Collects the primitives of a layer.
 	*
-	* Iterates over all entities in the game, checks if they have a primitive component, and if so, adds them to the list of primitives.
+	* Copies the members of the PRIMITIVES group of the layer, their primitive component is already resolved.
+	* @param layer The layer to collect.
 	* @param primitives A pointer to a vector where the collected primitives will be stored.
 	*/
-	void getPrimitives(primitives_t* primitives);
+	void getPrimitives(Layer layer, primitives_t* primitives);
 
 	/**
 	* @brief Sorts the primitives based on their layer and z-order.
@@ -1,58 +1,140 @@
+/**
+* @file RadarSystem.cpp
+* @author Hudson Schumaker
+* @brief Implements the RadarSystem class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "RadarSystem.h"
+#include "../EntityManager.h"
+#include "../component/Radar.h"
+#include "../component/Transform.h"
+#include "../../core/SortedDiff.h"
 
+RadarSystem::RadarSystem() {
+	reads<Radar, Transform>();
+}
 
+void RadarSystem::collect() {
+	EntityManager* entityManager = EntityManager::getInstance();
+	probes.clear();
 
+	// The radars, and the tags they look for
+	uint32_t tags = 0;
+	float largestRadius = 0.0f;
+	entityManager->view<Radar, Transform>().forEach([&](Entity* entity, Radar* radar, Transform* transform) {
+		Probe probe;
+		probe.id = entity->id;
+		probe.center = transform->position + radar->offset;
+		probe.radius = radar->r;
+		probe.hysteresis = std::max(radar->hysteresis, 0.0f);
+		probe.tag = radar->tag;
+		probes.push_back(probe);
 
+		tags |= 1u << static_cast<size_t>(radar->tag);
+		largestRadius = std::max(largestRadius, probe.radius + probe.hysteresis);
+	});
 
-#include "RadarSystem.h"
-#include "../EntityManager.h"
-#include "../component/Radar.h"
-#include "../component/Callback.h"
-#include "../component/Transform.h"
+	// Only the entities of those tags are targets
+	grid.clear();
+	grid.setCellSize(std::max(largestRadius, MIN_CELL_SIZE));
+	for (size_t tag = 0; tag < TAG_COUNT; tag++) {
+		if ((tags & (1u << tag)) == 0) {
+			continue;
+		}
+
+		for (auto& target : entityManager->getEntitiesWithTag(static_cast<Tag>(tag))) {
+			Vec2 center = target->getComponent<Transform>()->position + Vec2(TARGET_CENTER_OFFSET, TARGET_CENTER_OFFSET);
+			grid.add(static_cast<Tag>(tag), center, target->id);
+		}
+	}
+	grid.build();
+}
 
 void RadarSystem::update() {
-    // Get all entities with RigidBody components
-    auto chunks = calculateChunksAndThreads<Radar>();
-
-    // Vector to hold the threads
-    std::vector<std::thread> threads;
-
-    // For each chunk of entities, create a thread
-    for (const auto& chunk : chunks) {
-        threads.emplace_back([chunk] {
-            // For each entity in the chunk
-            for (auto& entity : chunk) {
-                auto components = entity->getComponents<Radar, Transform>();
-                Radar* radar = std::get<0>(components);         // Get the Radar component
-                Transform* transform = std::get<1>(components); // Get the Transform component    
-
-                // calculate
-                float radarX = transform->position.x + radar->offset.x;
-                float radarY = transform->position.y + radar->offset.y;
-                float radarRadius = radar->r;
-
-                auto enemies = EntityManager::getInstance()->getEntitiesWithTag(radar->tag);
-                for (auto& enemy : enemies) {
-                    if (enemy->tags.first == radar->tag) {
-                        Transform* enemyTransform = enemy->getComponent<Transform>();
-
-                        // Calculate the distance between the radar and the other entity
-                        float dx = (enemyTransform->position.x + 24) - radarX;
-                        float dy = (enemyTransform->position.y + 24) - radarY;
-                        float distance = std::sqrtf(dx * dx + dy * dy);
-
-                        // Check if the other entity is within the radar area
-                        if (distance <= radarRadius) {
-                            radar->onDetect(entity->id, enemy->id);
-                            break;
-                        }
-                    }
-                }    
-            }
-        });
-    }
-
-    // Wait for all threads to finish
-    for (auto& thread : threads) {
-        thread.join();
-    }
+	collect();
+	std::swap(previous, detections);
+	detections.clear();
+	transitions.clear();
+
+	size_t rangeCount = getRangeCount(probes.size());
+	if (rangeDetections.size() < rangeCount) {
+		rangeDetections.resize(rangeCount);
+	}
+
+	// Each range of radars writes to its own buffer, the previous detections are only read
+	parallelForRanges(probes.size(), [this](size_t range, size_t begin, size_t end) {
+		auto& buffer = rangeDetections[range];
+		buffer.clear();
+
+		for (size_t i = begin; i < end; i++) {
+			const Probe& probe = probes[i];
+			float radiusSquared = probe.radius * probe.radius;
+
+			grid.query(probe.tag, probe.center, probe.radius + probe.hysteresis, [&](const PointGrid::Point& point, float distanceSquared) {
+				if (point.id == probe.id) {
+					return;
+				}
+
+				// Within the margin a target is only kept, it does not enter
+				Detection detection = { probe.id, point.id };
+				if (distanceSquared <= radiusSquared || std::binary_search(previous.begin(), previous.end(), detection)) {
+					buffer.push_back(detection);
+				}
+			});
+		}
+	});
+
+	for (size_t range = 0; range < rangeCount; range++) {
+		detections.insert(detections.end(), rangeDetections[range].begin(), rangeDetections[range].end());
+	}
+	std::sort(detections.begin(), detections.end());
+
+	SortedDiff::compare(previous, detections,
+		[this](const Detection& detection) { transitions.push_back({ detection, false }); },
+		[this](const Detection& detection) { transitions.push_back({ detection, true }); });
+}
+
+void RadarSystem::getTargets(unsigned long radar, std::vector<unsigned long>& targets) const {
+	targets.clear();
+
+	auto it = std::lower_bound(detections.begin(), detections.end(), Detection{ radar, 0 });
+	for (; it != detections.end() && it->radar == radar; ++it) {
+		targets.push_back(it->target);
+	}
+}
+
+void RadarSystem::dispatchEvents() {
+	EntityManager* entityManager = EntityManager::getInstance();
+
+	for (const auto& transition : transitions) {
+		// The radar may have been removed by an earlier callback
+		const Detection& detection = transition.detection;
+		Entity* entity = entityManager->getEntity(detection.radar);
+		Radar* radar = entity ? entity->getComponent<Radar>() : nullptr;
+		if (radar == nullptr) {
+			continue;
+		}
+
+		if (transition.isEnter) {
+			radar->onDetect(detection.radar, detection.target);
+		}
+		else {
+			radar->onLeave(detection.radar, detection.target);
+		}
+	}
 }
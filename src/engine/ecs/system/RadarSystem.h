@@ -21,15 +21,77 @@
 */
 #pragma once
 #include "System.h"
+#include "../../physics/PointGrid.h"
 
 /**
  * @class RadarSystem
- * @brief Responsible for calualate target entities for radar entities in the game.
+ * @brief Tracks, for every entity with a Radar, the entities of the radar tag within its radius.
+ *
+ * The targets of the tags the radars look for are sorted into a PointGrid sized after the largest
+ * radius, so each radar only visits the cells around it, and the radars are queried in parallel
+ * ranges, each range writing to its own buffer. The detected targets of all the radars are kept
+ * as one sorted list of pairs, merged against the list of the previous frame to find the targets
+ * that entered or left. A detected target stays detected until it moves beyond the radius plus
+ * the hysteresis of the radar, so targets on the edge do not flicker. Only the transitions are
+ * reported, to Radar::onDetect and Radar::onLeave, later on the main thread by dispatchEvents().
  */
 class RadarSystem final : public System {
-public: 
-	RadarSystem() = default;
-	~RadarSystem() = default;
+private:
+    constexpr static const float TARGET_CENTER_OFFSET = 24.0f; // Targets are measured from the center of their 48 x 48 sprites
+    constexpr static const float MIN_CELL_SIZE = 16.0f;
 
+    struct Probe {
+        unsigned long id = 0;
+        Vec2 center;
+        float radius = 0.0f;
+        float hysteresis = 0.0f;
+        Tag tag = Tag::ENEMY;
+    };
+
+    struct Detection {
+        unsigned long radar = 0;
+        unsigned long target = 0;
+
+        bool operator<(const Detection& other) const {
+            return radar < other.radar || (radar == other.radar && target < other.target);
+        }
+    };
+
+    struct Transition {
+        Detection detection;
+        bool isEnter = true;
+    };
+
+    PointGrid grid;
+    std::vector<Probe> probes;
+    std::vector<std::vector<Detection>> rangeDetections;
+    std::vector<Detection> previous;   // Sorted
+    std::vector<Detection> detections; // Sorted
+    std::vector<Transition> transitions;
+
+    /**
+    * @brief Fills the probes from the radars and the grid from the targets of their tags.
+    */
+    void collect();
+
+public:
+    RadarSystem();
+    ~RadarSystem() = default;
+
+    /**
+    * @brief Finds the targets of every radar, and the ones that entered or left since the last update.
+    */
     void update();
+
+    /**
+    * @brief Returns the targets a radar detected in the last update.
+    * @param radar The id of the radar entity.
+    * @param targets The vector that receives the ids of the targets in increasing order, cleared first.
+    */
+    void getTargets(unsigned long radar, std::vector<unsigned long>& targets) const;
+
+    /**
+    * @brief Calls Radar::onDetect and Radar::onLeave for the transitions of the last update, on the main thread.
+    */
+    void dispatchEvents();
 };
@@ -24,36 +24,24 @@
 #include "../../gfx/Sprite.h"
 #include "../../gfx/Animation.h"
 #include "../../gfx/AnimationController.h"
+#include "../../core/JobSystem.h"
 
 RenderSystem::RenderSystem() {
 	this->renderer = Gfx::getInstance()->getRenderer();
+	reads<Sprite, Transform>();
+	writes<Animation, AnimationController>(); // Advances the animation frames
+	runOnMainThread();
 }
 
 void RenderSystem::update(const Camera* camera) {
-	renderables_t renderables;
 	renderables_t background;
 	renderables_t middleground;
 	renderables_t foreground;
 
-	getRenderables(&renderables);
-
-	// Filter renderables by Layer
-	for (auto& renderable : renderables) {
-		auto entity = std::get<0>(renderable);
-		if (entity->layer == Layer::BACKGROUND) {
-			background.push_back(renderable);
-			continue;
-		}
-
-		if (entity->layer == Layer::MIDDLEGROUND) {
-			middleground.push_back(renderable);
-			continue;
-		}
-
-		if (entity->layer == Layer::FOREGROUND) {
-			foreground.push_back(renderable);
-		}
-	}
+	// Collect the renderables of each Layer from the RENDERABLE group
+	getRenderables(Layer::BACKGROUND, &background);
+	getRenderables(Layer::MIDDLEGROUND, &middleground);
+	getRenderables(Layer::FOREGROUND, &foreground);
 
 	// Sort renderables by z-index
 	sortRenderables(&background, &middleground, &foreground);
@@ -71,47 +59,40 @@ void RenderSystem::update(const Camera* camera) {
 	}
 }
 
-void RenderSystem::getRenderables(renderables_t* renderables) {
-	auto renderableEntities = EntityManager::getInstance()->getEntitiesWithGroup(Group::RENDERABLE);
-
-	for (auto& pair : renderableEntities) {
-		Entity* entity = pair.first;
-		RenderType type = std::get<RenderType>(pair.second);
-		renderables->push_back(
-			std::make_tuple(
-				entity,
-				entity->getComponent<Transform>(),
-				type
-			)
-		);
+void RenderSystem::getRenderables(Layer layer, renderables_t* renderables) {
+	const auto& members = EntityManager::getInstance()->getGroup(Group::RENDERABLE, layer);
+	renderables->reserve(members.size());
+
+	for (auto& member : members) {
+		renderables->push_back(std::make_tuple(member.entity, member.transform, std::get<RenderType>(member.type)));
 	}
 }
 
 void RenderSystem::sortRenderables(renderables_t* background, renderables_t* middleground, renderables_t* foreground) {
-	auto bgFuture = std::async(std::launch::async, [&]() {
+	JobCounter counter{ 0 };
+
+	// Sort the background and middleground layers on the workers
+	JobSystem::getInstance()->submit([&]() {
 		std::sort(background->begin(), background->end(), [](const auto& a, const auto& b) {
 			return std::get<0>(a)->zIndex < std::get<0>(b)->zIndex;
 		});
-	});
+	}, counter);
 
-	auto mdFuture = std::async(std::launch::async, [&]() {
+	JobSystem::getInstance()->submit([&]() {
 		std::sort(middleground->begin(), middleground->end(), [](const auto& a, const auto& b) {
 			Transform* transformA = std::get<1>(a);
 			Transform* transformB = std::get<1>(b);
 			return transformA->position.y < transformB->position.y;
 		});
-	});
+	}, counter);
 
-	auto fgFuture = std::async(std::launch::async, [&]() {
-		std::sort(foreground->begin(), foreground->end(), [](const auto& a, const auto& b) {
-			return std::get<0>(a)->zIndex < std::get<0>(b)->zIndex;
-		});
+	// Sort the foreground layer on the calling thread
+	std::sort(foreground->begin(), foreground->end(), [](const auto& a, const auto& b) {
+		return std::get<0>(a)->zIndex < std::get<0>(b)->zIndex;
 	});
 
-	// Wait for all futures to complete
-	bgFuture.get();
-	mdFuture.get();
-	fgFuture.get();
+	// Wait for the other layers, helping the workers meanwhile
+	JobSystem::getInstance()->wait(counter);
 }
 
 void RenderSystem::renderSprite(renderable_t& renderable, const Camera* camera) {
@@ -40,10 +40,11 @@ private:
 	SDL_Renderer* renderer = nullptr;
 
 	/**
-	* @brief Collects all the renderable entities in the game.
+	* @brief Collects the renderable entities of a layer.
+	* @param layer The layer to collect.
 	* @param renderables A pointer to a vector where the collected renderable entities will be stored.
 	 */
-	void getRenderables(renderables_t* renderables);
+	void getRenderables(Layer layer, renderables_t* renderables);
 	
 	/**
 	* @brief Sorts the renderable entities based on their layer and z-order.
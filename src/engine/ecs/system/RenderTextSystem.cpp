@@ -28,6 +28,8 @@
 
 RenderTextSystem::RenderTextSystem() {
 	this->renderer = Gfx::getInstance()->getRenderer();
+	reads<TextLabel, SpriteText, Transform>();
+	runOnMainThread();
 }
 
 void RenderTextSystem::update(Camera* camera) {
@@ -36,11 +38,7 @@ void RenderTextSystem::update(Camera* camera) {
 }
 
 void RenderTextSystem::renderTextLabel(Camera* camera) {
-	auto entities = EntityManager::getInstance()->getEntitiesWithComponent<TextLabel>();
-
-	for (auto& entity : entities) {
-		TextLabel* textLabel = entity->getComponent<TextLabel>();
-		
+	EntityManager::getInstance()->view<TextLabel>().forEach([this, camera](Entity* entity, TextLabel* textLabel) {
 		// render
 		SDL_Rect dstRect = {
 			static_cast<int>(textLabel->position.x - (textLabel->isFixed ? 0 : camera->x)),
@@ -50,16 +48,11 @@ void RenderTextSystem::renderTextLabel(Camera* camera) {
 		};
 			
 		SDL_RenderCopy(renderer, textLabel->label, NULL, &dstRect);
-	}
+	});
 }
 
 void RenderTextSystem::renderSpriteText(Camera* camera) {
-	auto entities = EntityManager::getInstance()->getEntitiesWithComponent<SpriteText>();
-
-	for (auto& entity : entities) {
-		Transform* transform = entity->getComponent<Transform>();
-		SpriteText* spriteText = entity->getComponent<SpriteText>();
-
+	EntityManager::getInstance()->view<SpriteText, Transform>().forEach([this, camera](Entity* entity, SpriteText* spriteText, Transform* transform) {
 		// render
 		float newX = transform->position.x + spriteText->offSet.x;
 		float newY = transform->position.y + spriteText->offSet.y; 
@@ -75,5 +68,5 @@ void RenderTextSystem::renderSpriteText(Camera* camera) {
 		};
 			
 		SDL_RenderCopy(renderer, spriteText->label, NULL, &dstRect);
-	}
+	});
 }
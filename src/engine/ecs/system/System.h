@@ -22,39 +22,156 @@
 #pragma once
 #include "../../../Pch.h"
 #include "../EntityManager.h"
-#include "../../core/Hardware.h"
+#include "../../core/JobSystem.h"
+#include "../../core/Partitioner.h"
 #include "../component/Component.h"
 
 /**
 * @class System
 * @brief The base class for all systems.
+*
+* Each system declares the component types it reads and writes, so the SystemScheduler
+* can run the systems that do not conflict at the same time.
 */
 class System {
+private:
+    Signature readSet;
+    Signature writeSet;
+    bool mainThreadOnly = false;
+    Partitioner partitioner;
+
+protected:
+    /**
+    * @brief Declares that the system reads the specified component types.
+    */
+    template <typename... T>
+    void reads() {
+        readSet |= Component::getSignature<T...>();
+    }
+
+    /**
+    * @brief Declares that the system writes the specified component types.
+    */
+    template <typename... T>
+    void writes() {
+        writeSet |= Component::getSignature<T...>();
+    }
+
+    /**
+    * @brief Declares that the system must run on the main thread, e.g. because it uses the SDL renderer or event queue.
+    */
+    void runOnMainThread() {
+        mainThreadOnly = true;
+    }
+
 public:
-    template <typename Component>
-    static std::vector<std::vector<Entity*>> calculateChunksAndThreads() {
-        // Get all entities with the specified component
-        auto entities = EntityManager::getInstance()->getEntitiesWithComponent<Component>();
+    virtual ~System() = default;
+
+    /**
+    * @brief Returns the component types read by the system.
+    * @return The read signature.
+    */
+    const Signature& getReads() const {
+        return readSet;
+    }
+
+    /**
+    * @brief Returns the component types written by the system.
+    * @return The write signature.
+    */
+    const Signature& getWrites() const {
+        return writeSet;
+    }
 
-        // Get the number of these entities
-        int entitiesSize = static_cast<int>(entities.size());
+    /**
+    * @brief Checks if the system must run on the main thread.
+    * @return True if the system is main thread only, false otherwise.
+    */
+    bool isMainThreadOnly() const {
+        return mainThreadOnly;
+    }
 
-        // Get the number of threads based on the number of entities
-        int numThreads = Hardware::getThreadNumber(entitiesSize);
+    /**
+    * @brief Checks if the system and the other one cannot run at the same time.
+    * @param other The other system.
+    * @return True if one of them writes a component type the other reads or writes, false otherwise.
+    */
+    bool conflictsWith(const System& other) const {
+        return (writeSet & (other.writeSet | other.readSet)).any() || (readSet & other.writeSet).any();
+    }
 
-        // Calculate the size of each chunk for parallel processing
-        int chunkSize = (entitiesSize + numThreads - 1) / numThreads; // Round up division
+    /**
+    * @brief Splits the entities that have all the specified components into chunks sized from the measured cost of the system.
+    * @return Vector of chunks, each one a range of rows of a single archetype.
+    */
+    template <typename... T>
+    std::vector<ArchetypeChunk> calculateChunksAndThreads() const {
+        // Get the number of entities with the specified components
+        size_t entitiesSize = EntityManager::getInstance()->countEntitiesWith<T...>();
 
-        // Vector to hold the chunks of entities
-        std::vector<std::vector<Entity*>> chunks;
-        chunks.reserve(numThreads); // Reserve space for the chunks
+        // Divide the archetypes into chunks, iterated in place by the threads
+        return EntityManager::getInstance()->getChunks<T...>(partitioner.getGrainSize(entitiesSize));
+    }
 
-        // Divide the entities into chunks
-        for (int i = 0; i < entities.size(); i += chunkSize) {
-            chunks.emplace_back(entities.begin() + i, entities.begin() +
-                std::min(i + chunkSize, entitiesSize));
+    /**
+    * @brief Calls fn(chunk) for every chunk on the JobSystem workers and waits for all of them.
+    *
+    * The time spent on the chunks is fed back to the partitioner of the system.
+    * @param chunks The chunks to process.
+    * @param fn The function to call for each chunk.
+    */
+    template <typename F>
+    void parallelForChunks(const std::vector<ArchetypeChunk>& chunks, F&& fn) {
+        std::atomic<long long> nanoseconds = 0;
+        size_t entitiesSize = 0;
+        for (auto& chunk : chunks) {
+            entitiesSize += chunk.end - chunk.begin;
         }
 
-        return chunks;
+        JobSystem::getInstance()->parallelFor(0, chunks.size(), 1, [&chunks, &fn, &nanoseconds](size_t begin, size_t end) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = begin; i < end; i++) {
+                fn(chunks[i]);
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        });
+
+        partitioner.record(entitiesSize, nanoseconds);
+    }
+
+    /**
+    * @brief Splits [0, count) into ranges sized by the partitioner and calls fn(rangeIndex, begin, end) for each one on the JobSystem workers.
+    *
+    * The ranges are numbered in order, so each one can write to its own buffer and the buffers
+    * can be merged afterwards in a deterministic order without locks.
+    * @param count The number of items.
+    * @param fn The function to call for each range.
+    * @return The number of ranges.
+    */
+    template <typename F>
+    size_t parallelForRanges(size_t count, F&& fn) {
+        std::atomic<long long> nanoseconds = 0;
+        size_t grainSize = partitioner.getGrainSize(count);
+
+        JobSystem::getInstance()->parallelFor(0, count, grainSize, [&fn, &nanoseconds, grainSize](size_t begin, size_t end) {
+            auto start = std::chrono::steady_clock::now();
+            fn(begin / grainSize, begin, end);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        });
+
+        partitioner.record(count, nanoseconds);
+        return (count + grainSize - 1) / grainSize;
+    }
+
+    /**
+    * @brief Returns the number of ranges parallelForRanges() will use for the given count.
+    * @param count The number of items.
+    * @return The number of ranges.
+    */
+    size_t getRangeCount(size_t count) const {
+        size_t grainSize = partitioner.getGrainSize(count);
+        return (count + grainSize - 1) / grainSize;
     }
 };
@@ -0,0 +1,126 @@
+/**
+* @file SystemScheduler.cpp
+* @author Hudson Schumaker
+* @brief Implements the SystemScheduler class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "SystemScheduler.h"
+
+void SystemScheduler::add(System* system, const std::function<void()>& run) {
+	auto step = std::make_unique<Step>();
+	step->system = system;
+	step->run = run;
+	steps.push_back(std::move(step));
+	isDirty = true;
+}
+
+void SystemScheduler::clear() {
+	steps.clear();
+	isDirty = false;
+}
+
+void SystemScheduler::build() {
+	for (auto& step : steps) {
+		step->dependents.clear();
+		step->dependencies = 0;
+	}
+
+	for (size_t j = 0; j < steps.size(); j++) {
+		System* system = steps[j]->system;
+		for (size_t i = 0; i < j; i++) {
+			System* previous = steps[i]->system;
+
+			// Keep the order of the added systems only where they conflict
+			bool bothOnMainThread = system->isMainThreadOnly() && previous->isMainThreadOnly();
+			if (bothOnMainThread || system->conflictsWith(*previous)) {
+				steps[i]->dependents.push_back(j);
+				steps[j]->dependencies++;
+			}
+		}
+	}
+
+	isDirty = false;
+}
+
+void SystemScheduler::run() {
+	if (steps.empty()) {
+		return;
+	}
+
+	if (isDirty) {
+		build();
+	}
+
+	JobCounter counter = 0;
+	finishedSteps = 0;
+	for (auto& step : steps) {
+		step->remaining = step->dependencies;
+	}
+
+	// Start the roots of the graph
+	for (size_t i = 0; i < steps.size(); i++) {
+		if (steps[i]->dependencies == 0) {
+			dispatch(i, counter);
+		}
+	}
+
+	// Run the main thread steps as they are released, helping the workers meanwhile
+	while (finishedSteps < steps.size()) {
+		size_t index = steps.size();
+		{
+			std::lock_guard<std::mutex> lock(mainThreadMutex);
+			if (!mainThreadSteps.empty()) {
+				index = mainThreadSteps.front();
+				mainThreadSteps.pop_front();
+			}
+		}
+
+		if (index < steps.size()) {
+			steps[index]->run();
+			complete(index, counter);
+		}
+		else if (!JobSystem::getInstance()->runPendingJob()) {
+			std::this_thread::yield();
+		}
+	}
+
+	// The last jobs may still be returning
+	JobSystem::getInstance()->wait(counter);
+}
+
+void SystemScheduler::dispatch(size_t index, JobCounter& counter) {
+	if (steps[index]->system->isMainThreadOnly()) {
+		std::lock_guard<std::mutex> lock(mainThreadMutex);
+		mainThreadSteps.push_back(index);
+		return;
+	}
+
+	JobSystem::getInstance()->submit([this, index, &counter]() {
+		steps[index]->run();
+		complete(index, counter);
+	}, counter);
+}
+
+void SystemScheduler::complete(size_t index, JobCounter& counter) {
+	for (size_t dependent : steps[index]->dependents) {
+		if (--steps[dependent]->remaining == 0) {
+			dispatch(dependent, counter);
+		}
+	}
+	finishedSteps++;
+}
@@ -0,0 +1,92 @@
+/**
+* @file SystemScheduler.h
+* @author Hudson Schumaker
+* @brief Defines the SystemScheduler class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../../Pch.h"
+#include "System.h"
+#include "../../core/JobSystem.h"
+
+/**
+* @class SystemScheduler
+* @brief Runs the systems of a frame as a dependency graph on the JobSystem.
+*
+* Systems are added in the order they would be called by hand. A system depends on every
+* system added before it that conflicts with it (one of them writes a component type the
+* other reads or writes), and the main thread only systems run in the order they were added.
+* Systems without pending dependencies run at the same time on the workers, the main thread
+* runs the main thread only systems and helps the workers meanwhile.
+*/
+class SystemScheduler final {
+private:
+    struct Step {
+        System* system = nullptr;
+        std::function<void()> run;
+        std::vector<size_t> dependents;
+        int dependencies = 0;
+        std::atomic<int> remaining = 0;
+    };
+
+    std::vector<std::unique_ptr<Step>> steps;
+    std::deque<size_t> mainThreadSteps;
+    std::mutex mainThreadMutex;
+    std::atomic<size_t> finishedSteps = 0;
+    bool isDirty = false;
+
+    /**
+    * @brief Rebuilds the dependencies between the steps.
+    */
+    void build();
+
+    /**
+    * @brief Runs the step on a worker, or queues it for the main thread.
+    * @param index The index of the step.
+    * @param counter The counter of the jobs of the frame.
+    */
+    void dispatch(size_t index, JobCounter& counter);
+
+    /**
+    * @brief Releases the dependents of a finished step.
+    * @param index The index of the step.
+    * @param counter The counter of the jobs of the frame.
+    */
+    void complete(size_t index, JobCounter& counter);
+
+public:
+    SystemScheduler() = default;
+    ~SystemScheduler() = default;
+
+    /**
+    * @brief Adds a system to the frame.
+    * @param system Pointer to the system, used for its read and write sets.
+    * @param run The function that updates the system, e.g. [&] { movementSystem.update(dt); }.
+    */
+    void add(System* system, const std::function<void()>& run);
+
+    /**
+    * @brief Removes all the systems.
+    */
+    void clear();
+
+    /**
+    * @brief Runs all the systems once, returning when all of them have finished.
+    */
+    void run();
+};
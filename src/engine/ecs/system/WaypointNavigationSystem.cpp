@@ -24,72 +24,111 @@
 #include "../component/Transform.h"
 #include "../component/RigidBody.h"
 
+WaypointNavigationSystem::WaypointNavigationSystem() {
+	reads<RigidBody>();
+	writes<Waypoint, Transform>();
+}
+
 void WaypointNavigationSystem::update(float dt) {
-    // Get all entities with Waypoint component
-    auto chunks = calculateChunksAndThreads<Waypoint>();
-
-    // Vector to hold the threads
-    std::vector<std::thread> threads;
-
-    // For each chunk of entities, create a thread
-    for (const auto& chunk : chunks) {
-        threads.emplace_back([chunk, dt] {
-            // For each entity in the chunk
-            for (auto& entity : chunk) {
-
-                auto components = entity->getComponents<Waypoint, RigidBody, Transform>();
-                Waypoint* points = std::get<0>(components);     // Get the Waypoint component
-                RigidBody* rigidBody = std::get<1>(components); // Get the RigidBody component
-                Transform* transform = std::get<2>(components); // Get the Transform component
-
-                // If the entity has a RigidBody and Waypoints
-                if (rigidBody && !points->waypoints.empty()) {
-                    // Get the current waypoint
-                    auto currentWaypoint = points->waypoints.front();
-
-                    // Calculate the direction vector only if necessary
-                    if (points->direction.x == 0 && points->direction.y == 0) {
-                        float pointX = static_cast<float>(currentWaypoint.first);
-                        float pointY = static_cast<float>(currentWaypoint.second);
-
-                        float dx = pointX - transform->position.x;
-                        float dy = pointY - transform->position.y;
-                        float distance = std::sqrtf(dx * dx + dy * dy);
-                        
-                        // Normalize the direction vector
-                        points->direction.x = dx / distance;
-                        points->direction.y = dy / distance;
-                    }
-
-                    // Define an epsilon value for proximity check
-                    const float epsilon = 0.2f;
-
-                    // Check if the Entity has reached the Waypoint
-                    float dx = currentWaypoint.first - transform->position.x;
-                    float dy = currentWaypoint.second - transform->position.y;
-                    float distance = std::sqrtf(dx * dx + dy * dy);
-                    if (distance <= epsilon) {
-                        // Remove the current Waypoint from the list
-                        points->waypoints.erase(points->waypoints.begin());
-                        // Reset the direction to force recalculation
-                        points->direction.x = 0;
-                        points->direction.y = 0;
-                    } else {
-                        // Calculate the movement distances based on the speeds and delta time
-                        float movementDistanceX = rigidBody->velocity.x * dt;
-                        float movementDistanceY = rigidBody->velocity.y * dt;
-
-                        // Move the entity towards the waypoint
-                        transform->position.x += movementDistanceX * points->direction.x;
-                        transform->position.y += movementDistanceY * points->direction.y;
-                    }
+    // Get the chunks of the archetypes with Waypoint, RigidBody and Transform components
+    auto chunks = calculateChunksAndThreads<Waypoint, RigidBody, Transform>();
+
+    // Process each chunk of entities on the worker threads
+    parallelForChunks(chunks, [dt](const ArchetypeChunk& chunk) {
+        static thread_local std::vector<SplineFollower> followers;
+        followers.clear();
+
+        // For each entity in the chunk
+        EntityManager::forEachInChunk<Waypoint, RigidBody, Transform>(chunk, [dt](Entity* entity, Waypoint* points, RigidBody* rigidBody, Transform* transform) {
+            transform->previousPosition = transform->position;
+
+            // Spline followers are placed together after the loop
+            if (points->spline) {
+                points->elapsed += dt;
+
+                // A looping follower keeps its time within one lap, a float that grows for hours loses its fractions
+                float lapTime = points->speed > 0.0f ? points->spline->getLength() / points->speed : 0.0f;
+                if (points->isLooping && lapTime > 0.0f && points->elapsed >= lapTime) {
+                    points->elapsed = std::fmod(points->elapsed, lapTime);
                 }
+
+                followers.push_back({ points, transform });
+                return;
             }
+
+            followPath(points, rigidBody, transform, dt);
         });
+
+        followSplines(followers);
+    });
+}
+
+void WaypointNavigationSystem::followPath(Waypoint* points, RigidBody* rigidBody, Transform* transform, float dt) {
+    // If the entity has Waypoints left
+    if (!points->isFinished()) {
+        // Get the current waypoint
+        const Vec2& currentWaypoint = points->getTarget();
+
+        // Calculate the direction vector only if necessary
+        if (points->direction.x == 0 && points->direction.y == 0) {
+            float dx = currentWaypoint.x - transform->position.x;
+            float dy = currentWaypoint.y - transform->position.y;
+            float distance = std::sqrtf(dx * dx + dy * dy);
+            
+            // Normalize the direction vector
+            points->direction.x = dx / distance;
+            points->direction.y = dy / distance;
+        }
+
+        // Define an epsilon value for proximity check
+        const float epsilon = 0.2f;
+
+        // Check if the Entity has reached the Waypoint
+        float dx = currentWaypoint.x - transform->position.x;
+        float dy = currentWaypoint.y - transform->position.y;
+        float distance = std::sqrtf(dx * dx + dy * dy);
+        if (distance <= epsilon) {
+            // Move the cursor to the next Waypoint, resetting the direction to force recalculation
+            points->advance();
+        } else {
+            // Calculate the movement distances based on the speeds and delta time
+            float movementDistanceX = rigidBody->velocity.x * dt;
+            float movementDistanceY = rigidBody->velocity.y * dt;
+
+            // Move the entity towards the waypoint
+            transform->position.x += movementDistanceX * points->direction.x;
+            transform->position.y += movementDistanceY * points->direction.y;
+        }
     }
+}
+
+void WaypointNavigationSystem::followSplines(const std::vector<SplineFollower>& followers) {
+    static thread_local std::vector<float> distances;
+    static thread_local std::vector<Vec2> positions;
+
+    size_t begin = 0;
+    while (begin < followers.size()) {
+        // Find the run of entities on the same spline, a formation is created together
+        const SplinePath* spline = followers[begin].waypoint->spline.get();
+        size_t end = begin + 1;
+        while (end < followers.size() && followers[end].waypoint->spline.get() == spline) {
+            end++;
+        }
+
+        size_t count = end - begin;
+        distances.resize(count);
+        positions.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            distances[i] = followers[begin + i].waypoint->getDistance();
+        }
+
+        spline->getPositions(distances.data(), positions.data(), count);
+
+        for (size_t i = 0; i < count; i++) {
+            const SplineFollower& follower = followers[begin + i];
+            follower.transform->position = positions[i] + follower.waypoint->offset;
+        }
 
-    // Wait for all threads to finish
-    for (auto& thread : threads) {
-        thread.join();
+        begin = end;
     }
 }
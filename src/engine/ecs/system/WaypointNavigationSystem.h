@@ -22,14 +22,43 @@
 #pragma once
 #include "System.h"
 
+class Waypoint;
+class RigidBody;
+class Transform;
+
 /**
 * @class WaypointNavigationSystem
 * @brief Responsible for updating the navigation of entities with waypoints.
 *
 * The WaypointNavigationSystem class is part of the game's navigation system. It updates the navigation of entities that have waypoints, moving them towards their next waypoint based on the time elapsed since the last frame.
+* Entities that follow a spline are placed directly at the distance travelled along it, the ones
+* of a chunk that share a spline are evaluated together in one batch.
 */
 class WaypointNavigationSystem final : public System {
+private:
+    struct SplineFollower {
+        Waypoint* waypoint = nullptr;
+        Transform* transform = nullptr;
+    };
+
+    /**
+    * @brief Moves an entity towards the next point of its path.
+    * @param points The Waypoint of the entity.
+    * @param rigidBody The RigidBody of the entity.
+    * @param transform The Transform of the entity.
+    * @param dt The time elapsed since the last frame.
+    */
+    static void followPath(Waypoint* points, RigidBody* rigidBody, Transform* transform, float dt);
+
+    /**
+    * @brief Places the entities on their splines, one batch per run of entities that share a spline.
+    * @param followers The entities, ordered as in their chunk.
+    */
+    static void followSplines(const std::vector<SplineFollower>& followers);
+
 public:
+    WaypointNavigationSystem();
+    ~WaypointNavigationSystem() = default;
 
     /**
     * @brief Updates the navigation of entities with waypoints.
@@ -0,0 +1,40 @@
+/**
+* @file CollisionEvent.h
+* @author Hudson Schumaker
+* @brief Defines the CollisionEvent class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "Event.h"
+#include "../physics/PhysicsTypes.h"
+
+/**
+ * @class CollisionEvent
+ * @brief Event for two entities that started or stopped touching.
+ *
+ * Carries ids rather than pointers, on exit one of the entities may already be removed.
+ */
+class CollisionEvent final : public Event {
+public:
+    unsigned long a;
+    unsigned long b;
+    ContactPhase phase;
+
+    CollisionEvent(unsigned long a, unsigned long b, ContactPhase phase) : a(a), b(b), phase(phase) {}
+    ~CollisionEvent() = default;
+};
@@ -21,6 +21,7 @@
 */
 #pragma once
 #include "Event.h"
+#include "CollisionEvent.h"
 #include "MouseClickEvent.h"
 #include "MouseHoverEvent.h"
 #include "MouseWheelEvent.h"
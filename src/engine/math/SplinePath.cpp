@@ -0,0 +1,164 @@
+/**
+* @file SplinePath.cpp
+* @author Hudson Schumaker
+* @brief Implements the SplinePath class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "SplinePath.h"
+
+SplinePath::SplinePath(SplineType type, const std::vector<Vec2>& controlPoints, float step) : type(type), controlPoints(controlPoints) {
+	if (step > 0.0f) {
+		this->step = step;
+		this->invStep = 1.0f / step;
+	}
+	else {
+		std::cerr << "SplinePath: invalid step " << step << std::endl;
+	}
+
+	if (controlPoints.size() < 2) {
+		std::cerr << "SplinePath: a path needs at least 2 points, got " << controlPoints.size() << std::endl;
+	}
+	else if (type == SplineType::BEZIER && (controlPoints.size() - 1) % 3 != 0) {
+		std::cerr << "SplinePath: a Bezier path needs 3n + 1 points, the last " << (controlPoints.size() - 1) % 3 << " are ignored" << std::endl;
+	}
+
+	build();
+}
+
+std::shared_ptr<const SplinePath> SplinePath::create(SplineType type, const std::vector<Vec2>& controlPoints, float step) {
+	return std::make_shared<const SplinePath>(type, controlPoints, step);
+}
+
+size_t SplinePath::getPieceCount() const {
+	if (controlPoints.size() < 2) {
+		return 0;
+	}
+
+	if (type == SplineType::BEZIER) {
+		return (controlPoints.size() - 1) / 3;
+	}
+	return controlPoints.size() - 1;
+}
+
+Vec2 SplinePath::evaluate(size_t piece, float t) const {
+	float t2 = t * t;
+	float t3 = t2 * t;
+
+	if (type == SplineType::BEZIER) {
+		const Vec2& p0 = controlPoints[piece * 3];
+		const Vec2& p1 = controlPoints[piece * 3 + 1];
+		const Vec2& p2 = controlPoints[piece * 3 + 2];
+		const Vec2& p3 = controlPoints[piece * 3 + 3];
+
+		float u = 1.0f - t;
+		float b0 = u * u * u;
+		float b1 = 3.0f * u * u * t;
+		float b2 = 3.0f * u * t2;
+		return Vec2(
+			b0 * p0.x + b1 * p1.x + b2 * p2.x + t3 * p3.x,
+			b0 * p0.y + b1 * p1.y + b2 * p2.y + t3 * p3.y
+		);
+	}
+
+	// Uniform Catmull-Rom, the end points are repeated to give the first and last pieces their tangents
+	size_t last = controlPoints.size() - 1;
+	const Vec2& p0 = controlPoints[piece == 0 ? 0 : piece - 1];
+	const Vec2& p1 = controlPoints[piece];
+	const Vec2& p2 = controlPoints[piece + 1];
+	const Vec2& p3 = controlPoints[std::min(piece + 2, last)];
+
+	float c0 = -0.5f * t3 + t2 - 0.5f * t;
+	float c1 = 1.5f * t3 - 2.5f * t2 + 1.0f;
+	float c2 = -1.5f * t3 + 2.0f * t2 + 0.5f * t;
+	float c3 = 0.5f * t3 - 0.5f * t2;
+	return Vec2(
+		c0 * p0.x + c1 * p1.x + c2 * p2.x + c3 * p3.x,
+		c0 * p0.y + c1 * p1.y + c2 * p2.y + c3 * p3.y
+	);
+}
+
+void SplinePath::build() {
+	table.clear();
+	length = 0.0f;
+
+	size_t pieces = getPieceCount();
+	if (pieces == 0) {
+		if (!controlPoints.empty()) {
+			table.push_back(controlPoints.front());
+		}
+		return;
+	}
+
+	// Sample the curve finely, measuring the length travelled at every sample
+	std::vector<Vec2> samples;
+	std::vector<float> distances;
+	samples.reserve(pieces * SUBDIVISIONS + 1);
+	distances.reserve(pieces * SUBDIVISIONS + 1);
+	samples.push_back(evaluate(0, 0.0f));
+	distances.push_back(0.0f);
+
+	for (size_t piece = 0; piece < pieces; piece++) {
+		for (int i = 1; i <= SUBDIVISIONS; i++) {
+			Vec2 sample = evaluate(piece, static_cast<float>(i) / SUBDIVISIONS);
+			length += (sample - samples.back()).magnitude();
+			samples.push_back(sample);
+			distances.push_back(length);
+		}
+	}
+
+	// Resample at equal distances, both lists only move forward
+	size_t count = static_cast<size_t>(std::ceil(length * invStep)) + 1;
+	table.reserve(count);
+	size_t sample = 0;
+	for (size_t i = 0; i + 1 < count; i++) {
+		float distance = static_cast<float>(i) * step;
+		while (sample + 2 < distances.size() && distances[sample + 1] < distance) {
+			sample++;
+		}
+
+		float span = distances[sample + 1] - distances[sample];
+		float t = span > 0.0f ? (distance - distances[sample]) / span : 0.0f;
+		const Vec2& a = samples[sample];
+		const Vec2& b = samples[sample + 1];
+		table.emplace_back(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+	}
+
+	// The last entry is a whole step after the previous one, past the end, so interpolating
+	// up to the length lands exactly on the end
+	if (table.empty()) {
+		table.push_back(samples.back());
+		return;
+	}
+
+	Vec2 previous = table.back();
+	float remaining = length - static_cast<float>(count - 2) * step;
+	Vec2 end = samples.back();
+	float scale = remaining > 0.0f ? step / remaining : 1.0f;
+	table.emplace_back(previous.x + (end.x - previous.x) * scale, previous.y + (end.y - previous.y) * scale);
+}
+
+void SplinePath::getPositions(const float* distances, Vec2* positions, size_t count) const {
+	if (table.empty()) {
+		std::fill(positions, positions + count, Vec2());
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		positions[i] = interpolate(distances[i]);
+	}
+}
@@ -0,0 +1,136 @@
+/**
+* @file SplinePath.h
+* @author Hudson Schumaker
+* @brief Defines the SplinePath class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Vec2.h"
+
+/**
+* @enum SplineType
+* @brief The curves a SplinePath can be built from.
+*/
+enum class SplineType {
+    CATMULL_ROM, // Passes through every point
+    BEZIER       // Cubic pieces, the points are start, control, control, end, control, control, end...
+};
+
+/**
+* @class SplinePath
+* @brief An immutable smooth path, evaluated by the distance travelled along it.
+*
+* The curve is sampled finely when the path is built and resampled into a table of points at
+* equal distances along it, so the position at a distance is found with one index and one
+* interpolation, whatever the length of the path, and the curve is never evaluated again.
+* The path is shared by all the Waypoint components that follow it.
+*/
+class SplinePath final {
+private:
+    constexpr static const int SUBDIVISIONS = 32; // Samples per piece of curve, to measure its length
+
+    SplineType type = SplineType::CATMULL_ROM;
+    std::vector<Vec2> controlPoints;
+    std::vector<Vec2> table;   // Points every step along the curve, the last one at its end
+    float step = 2.0f;
+    float invStep = 0.5f;
+    float length = 0.0f;
+
+    /**
+    * @brief Returns the number of pieces of curve.
+    * @return The number of pieces.
+    */
+    size_t getPieceCount() const;
+
+    /**
+    * @brief Evaluates a piece of the curve.
+    * @param piece The index of the piece.
+    * @param t The parameter, between 0 and 1.
+    * @return The point.
+    */
+    Vec2 evaluate(size_t piece, float t) const;
+
+    /**
+    * @brief Fills the table of points at equal distances.
+    */
+    void build();
+
+    /**
+    * @brief Interpolates the table at a distance along the path.
+    * @param distance The distance from the start, clamped to the path.
+    * @return The point, the table must not be empty.
+    */
+    Vec2 interpolate(float distance) const {
+        float position = std::clamp(distance, 0.0f, length) * invStep;
+        size_t index = std::min(static_cast<size_t>(position), table.size() - 1);
+        size_t next = std::min(index + 1, table.size() - 1);
+        float t = position - static_cast<float>(index);
+
+        const Vec2& a = table[index];
+        const Vec2& b = table[next];
+        return Vec2(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+    }
+
+public:
+    /**
+    * @brief Builds a spline path.
+    * @param type The type of the curve.
+    * @param controlPoints The points of the curve, at least 2, and 3n + 1 for Bezier curves.
+    * @param step The distance between the points of the table, smaller is more precise.
+    */
+    SplinePath(SplineType type, const std::vector<Vec2>& controlPoints, float step = 2.0f);
+    ~SplinePath() = default;
+
+    /**
+    * @brief Creates a shared spline path.
+    * @param type The type of the curve.
+    * @param controlPoints The points of the curve, at least 2, and 3n + 1 for Bezier curves.
+    * @param step The distance between the points of the table, smaller is more precise.
+    * @return Shared pointer to the new path.
+    */
+    static std::shared_ptr<const SplinePath> create(SplineType type, const std::vector<Vec2>& controlPoints, float step = 2.0f);
+
+    /**
+    * @brief Returns the length of the path.
+    * @return The length.
+    */
+    float getLength() const {
+        return length;
+    }
+
+    /**
+    * @brief Returns the point at a distance along the path.
+    * @param distance The distance from the start, clamped to the path.
+    * @return The point.
+    */
+    Vec2 getPosition(float distance) const {
+        if (table.empty()) {
+            return Vec2();
+        }
+        return interpolate(distance);
+    }
+
+    /**
+    * @brief Returns the points at many distances along the path, in one pass without branches on the curve.
+    * @param distances The distances from the start, clamped to the path.
+    * @param positions Receives the points, as many as distances.
+    * @param count The number of distances.
+    */
+    void getPositions(const float* distances, Vec2* positions, size_t count) const;
+};
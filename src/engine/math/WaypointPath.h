@@ -0,0 +1,82 @@
+/**
+* @file WaypointPath.h
+* @author Hudson Schumaker
+* @brief Defines the WaypointPath class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Vec2.h"
+
+/**
+* @class WaypointPath
+* @brief An immutable list of points to follow, shared by all the Waypoint components that follow it.
+*
+* A formation of ships holds one path and each ship only keeps its own cursor into it, so the
+* points are stored once and never copied nor modified while the ships advance.
+*/
+class WaypointPath final {
+private:
+    std::vector<Vec2> points;
+
+public:
+    WaypointPath(const std::vector<Vec2>& points) : points(points) {}
+    ~WaypointPath() = default;
+
+    /**
+    * @brief Creates a shared path.
+    * @param points The points of the path, in order.
+    * @return Shared pointer to the new path.
+    */
+    static std::shared_ptr<const WaypointPath> create(const std::vector<Vec2>& points) {
+        return std::make_shared<const WaypointPath>(points);
+    }
+
+    /**
+    * @brief Returns the number of points of the path.
+    * @return The number of points.
+    */
+    size_t size() const {
+        return points.size();
+    }
+
+    /**
+    * @brief Returns a point of the path.
+    * @param index The index of the point, lower than size().
+    * @return Constant reference to the point.
+    */
+    const Vec2& getPoint(size_t index) const {
+        return points[index];
+    }
+
+    /**
+    * @brief Returns the points of the path.
+    * @return Constant reference to the vector of points.
+    */
+    const std::vector<Vec2>& getPoints() const {
+        return points;
+    }
+
+    /**
+    * @brief Appends a point, only for the owner of a path that is not shared yet.
+    * @param point The point.
+    */
+    void addPoint(const Vec2& point) {
+        points.push_back(point);
+    }
+};
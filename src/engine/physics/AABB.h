@@ -0,0 +1,94 @@
+/**
+* @file AABB.h
+* @author Hudson Schumaker
+* @brief Defines the AABB struct.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "../math/Vec2.h"
+
+/**
+* @struct AABB
+* @brief An axis-aligned bounding box, in world coordinates.
+*/
+struct AABB {
+    Vec2 min;
+    Vec2 max;
+
+    AABB() = default;
+    AABB(const Vec2& min, const Vec2& max) : min(min), max(max) {}
+    ~AABB() = default;
+
+    /**
+    * @brief Checks if the box overlaps another box, touching edges count as overlapping.
+    * @param other The other box.
+    * @return True if the boxes overlap, false otherwise.
+    */
+    bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+            min.y <= other.max.y && max.y >= other.min.y;
+    }
+
+    /**
+    * @brief Checks if the box fully contains another box.
+    * @param other The other box.
+    * @return True if the other box is inside this one, false otherwise.
+    */
+    bool contains(const AABB& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y &&
+            max.x >= other.max.x && max.y >= other.max.y;
+    }
+
+    /**
+    * @brief Returns the smallest box that contains this box and another one.
+    * @param other The other box.
+    * @return The merged box.
+    */
+    AABB merge(const AABB& other) const {
+        return AABB(
+            Vec2(std::min(min.x, other.min.x), std::min(min.y, other.min.y)),
+            Vec2(std::max(max.x, other.max.x), std::max(max.y, other.max.y))
+        );
+    }
+
+    /**
+    * @brief Returns the box grown by a margin on every side.
+    * @param margin The margin.
+    * @return The grown box.
+    */
+    AABB expand(float margin) const {
+        return AABB(Vec2(min.x - margin, min.y - margin), Vec2(max.x + margin, max.y + margin));
+    }
+
+    /**
+    * @brief Returns the perimeter of the box, the cost used to balance box trees.
+    * @return The perimeter.
+    */
+    float perimeter() const {
+        return 2.0f * ((max.x - min.x) + (max.y - min.y));
+    }
+
+    /**
+    * @brief Returns the center of the box.
+    * @return The center.
+    */
+    Vec2 center() const {
+        return Vec2((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f);
+    }
+};
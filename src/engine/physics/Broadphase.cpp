@@ -0,0 +1,68 @@
+/**
+* @file Broadphase.cpp
+* @author Hudson Schumaker
+* @brief Implements the Broadphase class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "Broadphase.h"
+#include "../ecs/EntityManager.h"
+#include "../ecs/component/BoxCollider.h"
+#include "../ecs/component/CircleCollider.h"
+
+void Broadphase::collectProxies(std::vector<ColliderProxy>& proxies, const CollisionMatrix& matrix) {
+	proxies.clear();
+
+	for (size_t layer = 0; layer < LAYER_COUNT; layer++) {
+		for (auto& member : EntityManager::getInstance()->getGroup(Group::COLLIDER, static_cast<Layer>(layer))) {
+			ColliderProxy proxy;
+			proxy.entity = member.entity;
+			proxy.id = member.entity->id;
+			proxy.transform = member.transform;
+			proxy.collider = member.component;
+			proxy.rigidBody = member.entity->getComponent<RigidBody>();
+			proxy.type = std::get<ColliderType>(member.type);
+			proxy.bounds = computeBounds(proxy);
+			proxy.category = CollisionMatrix::getCategory(member.entity->getTag());
+			proxy.mask = matrix.getMask(member.entity->getTag());
+			proxies.push_back(proxy);
+		}
+	}
+}
+
+void Broadphase::updateExtent(const std::vector<ColliderProxy>& proxies) {
+	extent = proxies.empty() ? AABB() : proxies[0].bounds;
+	for (const auto& proxy : proxies) {
+		extent = extent.merge(proxy.bounds);
+	}
+}
+
+AABB Broadphase::computeBounds(const ColliderProxy& proxy) {
+	const Transform* transform = proxy.transform;
+
+	if (proxy.type == ColliderType::CIRCLE) {
+		const CircleCollider* circle = static_cast<const CircleCollider*>(proxy.collider);
+		float radius = circle->radius * std::max(transform->scale.x, transform->scale.y);
+		Vec2 center = transform->position + circle->offset;
+		return AABB(Vec2(center.x - radius, center.y - radius), Vec2(center.x + radius, center.y + radius));
+	}
+
+	const BoxCollider* box = static_cast<const BoxCollider*>(proxy.collider);
+	Vec2 min = transform->position + box->offset;
+	Vec2 max(min.x + box->bounds.w * transform->scale.x, min.y + box->bounds.h * transform->scale.y);
+	return AABB(min, max);
+}
@@ -0,0 +1,143 @@
+/**
+* @file Broadphase.h
+* @author Hudson Schumaker
+* @brief Defines the Broadphase interface and the ColliderProxy struct.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "AABB.h"
+#include "PhysicsTypes.h"
+#include "CollisionMatrix.h"
+#include "../ecs/component/Component.h"
+#include "../ecs/component/Transform.h"
+#include "../ecs/component/RigidBody.h"
+
+class Entity;
+
+/**
+* @struct ColliderProxy
+* @brief The broadphase view of a collider: the entity, its resolved components and its world bounds.
+*/
+struct ColliderProxy {
+    Entity* entity = nullptr;
+    unsigned long id = 0;          // Id of the entity, still valid after the entity is removed
+    Transform* transform = nullptr;
+    Component* collider = nullptr; // BoxCollider or CircleCollider, see type
+    RigidBody* rigidBody = nullptr;
+    ColliderType type = ColliderType::BOX;
+    AABB bounds;
+    uint32_t category = ~0u; // Bit of the tag of the entity
+    uint32_t mask = ~0u;     // Bits of the tags it collides with, see CollisionMatrix
+
+    /**
+    * @brief Checks if the tags of two proxies collide, without testing their bounds.
+    * @param other The other proxy.
+    * @return True if they may collide, false otherwise.
+    */
+    bool canCollide(const ColliderProxy& other) const {
+        return (mask & other.category) != 0;
+    }
+
+    /**
+    * @brief Checks if the collider did not move in the last frame, stopped, asleep or without a RigidBody.
+    * @return True if it rests, false otherwise.
+    */
+    bool isResting() const {
+        return (rigidBody == nullptr || !rigidBody->isMoving || rigidBody->isSleeping) && transform->position == transform->previousPosition;
+    }
+
+    /**
+    * @brief Checks if the RigidBody of the collider is asleep.
+    * @return True if it sleeps, false if it is awake or has no RigidBody.
+    */
+    bool isSleeping() const {
+        return rigidBody != nullptr && rigidBody->isSleeping;
+    }
+};
+
+/**
+* @struct BroadphasePair
+* @brief Two proxies whose bounds overlap, as indices into the proxies given to Broadphase::update(), with a < b.
+*/
+struct BroadphasePair {
+    size_t a = 0;
+    size_t b = 0;
+};
+
+/**
+* @class Broadphase
+* @brief The base class of the structures that find the colliders that may touch without testing every pair.
+*/
+class Broadphase {
+protected:
+    AABB extent; // Union of the bounds of the proxies of the last update
+
+    /**
+    * @brief Recomputes the extent from the proxies of the frame, called by update().
+    * @param proxies The proxies of all the colliders.
+    */
+    void updateExtent(const std::vector<ColliderProxy>& proxies);
+
+public:
+    virtual ~Broadphase() = default;
+
+    /**
+    * @brief Returns the union of the bounds of the proxies of the last update, a query outside it finds nothing.
+    * @return The extent, empty at the origin when there are no proxies.
+    */
+    const AABB& getExtent() const {
+        return extent;
+    }
+
+    /**
+    * @brief Indexes the proxies of the frame, the vector must stay alive until the next update.
+    * @param proxies The proxies of all the colliders.
+    */
+    virtual void update(const std::vector<ColliderProxy>& proxies) = 0;
+
+    /**
+    * @brief Appends every pair of proxies whose bounds overlap and whose tags collide, each pair once.
+    * @param pairs The vector that receives the pairs.
+    */
+    virtual void findPairs(std::vector<BroadphasePair>& pairs) const = 0;
+
+    /**
+    * @brief Appends the proxies whose bounds overlap the given bounds, each proxy once.
+    * @param bounds The bounds to test.
+    * @param result The vector that receives the indices of the proxies.
+    */
+    virtual void query(const AABB& bounds, std::vector<size_t>& result) const = 0;
+
+    /**
+    * @brief Fills the proxies from the COLLIDER group of the EntityManager.
+    *
+    * Box colliders span from position + offset to that corner plus their scaled bounds, and
+    * circle colliders are centered at position + offset with their radius scaled by the larger scale.
+    * @param proxies The vector that receives the proxies, cleared first.
+    * @param matrix The matrix that gives the mask of the tag of each entity.
+    */
+    static void collectProxies(std::vector<ColliderProxy>& proxies, const CollisionMatrix& matrix);
+
+    /**
+    * @brief Computes the world bounds of a collider.
+    * @param proxy The proxy with its transform, collider and type set.
+    * @return The bounds.
+    */
+    static AABB computeBounds(const ColliderProxy& proxy);
+};
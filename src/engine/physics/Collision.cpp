@@ -24,12 +24,43 @@
 void Collision::resolveCollision() {
 	// Apply positional correction using the projection method
 	resolvePenetration();
-	// TODO: calculate the collision impulse
+
+	// Bodies without a RigidBody do not move
+	float invMassA = rA ? rA->invMass : 0.0f;
+	float invMassB = rB ? rB->invMass : 0.0f;
+	if (invMassA + invMassB == 0.0f) {
+		return;
+	}
+
+	// Only bodies moving towards each other need an impulse
+	Vec2 velocityA = rA ? rA->velocity : Vec2::zero();
+	Vec2 velocityB = rB ? rB->velocity : Vec2::zero();
+	float normalVelocity = (velocityB - velocityA).dot(normal);
+	if (normalVelocity >= 0.0f) {
+		return;
+	}
+
+	float restitution = std::min(rA ? rA->restitution : 1.0f, rB ? rB->restitution : 1.0f);
+	float impulse = -(1.0f + restitution) * normalVelocity / (invMassA + invMassB);
+
+	if (rA) {
+		rA->velocity -= normal * (impulse * invMassA);
+	}
+	if (rB) {
+		rB->velocity += normal * (impulse * invMassB);
+	}
 }
 
 void Collision::resolvePenetration() {
-	float dA = depth / (rA->invMass + rB->invMass) * rA->invMass;
-	float dB = depth / (rA->invMass + rB->invMass) * rB->invMass;
+	// Bodies without a RigidBody do not move
+	float invMassA = rA ? rA->invMass : 0.0f;
+	float invMassB = rB ? rB->invMass : 0.0f;
+	if (invMassA + invMassB == 0.0f) {
+		return;
+	}
+
+	float dA = depth / (invMassA + invMassB) * invMassA;
+	float dB = depth / (invMassA + invMassB) * invMassB;
 
 	tA->position -= normal * dA;
 	tB->position += normal * dB;
@@ -22,9 +22,15 @@
 #pragma once
 #include "../ecs/component/Transform.h"
 #include "../ecs/component/RigidBody.h"
+#include "../ecs/component/BoxCollider.h"
 #include "../ecs/component/CircleCollider.h"
 
+class Entity;
+
 struct Collision {
+	Entity* eA = nullptr;
+	Entity* eB = nullptr;
+
 	Transform* tA = nullptr;
 	Transform* tB = nullptr;
 
@@ -34,12 +40,19 @@ struct Collision {
 	CircleCollider* cA = nullptr;
 	CircleCollider* cB = nullptr;
 
+	BoxCollider* bA = nullptr;
+	BoxCollider* bB = nullptr;
+
+	// start is the deepest point of B inside A, end the deepest point of A inside B,
+	// normal points from A to B and end = start + normal * depth
 	Vec2 start, end, normal;
 	float depth = 0.0f;
 
 	Collision() = default;
 	~Collision() = default;
 
+	// Separates the bodies and applies the impulse that bounces them apart, for a single contact,
+	// many contacts are solved together by the ContactSolver
 	void resolveCollision();
 	void resolvePenetration();
 };
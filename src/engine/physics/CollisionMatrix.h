@@ -0,0 +1,110 @@
+/**
+* @file CollisionMatrix.h
+* @author Hudson Schumaker
+* @brief Defines the CollisionMatrix class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "../ecs/TLG.h"
+
+static_assert(TAG_COUNT <= 32, "CollisionMatrix stores the tags of a row in 32 bits");
+
+/**
+* @class CollisionMatrix
+* @brief Tells which tags collide with which, one bit mask per tag.
+*
+* The row of a tag has the bit of every tag it collides with, and the matrix is kept symmetric,
+* so two colliders may touch when (mask of the first & category of the second) != 0, without
+* branches. Every tag collides with every tag by default.
+*/
+class CollisionMatrix final {
+private:
+    std::array<uint32_t, TAG_COUNT> masks;
+
+public:
+    CollisionMatrix() {
+        reset();
+    }
+
+    ~CollisionMatrix() = default;
+
+    /**
+    * @brief Returns the bit of a tag, to test against the masks.
+    * @param tag The tag.
+    * @return The bit of the tag.
+    */
+    static uint32_t getCategory(Tag tag) {
+        return 1u << static_cast<size_t>(tag);
+    }
+
+    /**
+    * @brief Returns the bits of the tags a tag collides with.
+    * @param tag The tag.
+    * @return The mask of the tag.
+    */
+    uint32_t getMask(Tag tag) const {
+        return masks[static_cast<size_t>(tag)];
+    }
+
+    /**
+    * @brief Checks if two tags collide.
+    * @param a The first tag.
+    * @param b The second tag.
+    * @return True if they collide, false otherwise.
+    */
+    bool collides(Tag a, Tag b) const {
+        return (getMask(a) & getCategory(b)) != 0;
+    }
+
+    /**
+    * @brief Sets if two tags collide, in both directions.
+    * @param a The first tag.
+    * @param b The second tag, may be the same as the first one.
+    * @param collides True to collide, false to ignore each other.
+    */
+    void set(Tag a, Tag b, bool collides) {
+        size_t rowA = static_cast<size_t>(a);
+        size_t rowB = static_cast<size_t>(b);
+        if (collides) {
+            masks[rowA] |= getCategory(b);
+            masks[rowB] |= getCategory(a);
+        }
+        else {
+            masks[rowA] &= ~getCategory(b);
+            masks[rowB] &= ~getCategory(a);
+        }
+    }
+
+    /**
+    * @brief Makes a tag collide with nothing, e.g. Tag::UI.
+    * @param tag The tag.
+    */
+    void ignore(Tag tag) {
+        for (size_t other = 0; other < TAG_COUNT; other++) {
+            set(tag, static_cast<Tag>(other), false);
+        }
+    }
+
+    /**
+    * @brief Makes every tag collide with every tag.
+    */
+    void reset() {
+        masks.fill((1u << TAG_COUNT) - 1);
+    }
+};
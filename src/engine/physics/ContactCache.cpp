@@ -0,0 +1,73 @@
+/**
+* @file ContactCache.cpp
+* @author Hudson Schumaker
+* @brief Implements the ContactCache class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "ContactCache.h"
+#include "../ecs/Entity.h"
+#include "../core/SortedDiff.h"
+
+void ContactCache::update(const std::vector<Collision>& contacts) {
+	std::swap(previous, current);
+	current.clear();
+	transitions.clear();
+
+	for (const auto& contact : contacts) {
+		if (contact.eA == nullptr || contact.eB == nullptr) {
+			continue;
+		}
+
+		unsigned long a = contact.eA->id;
+		unsigned long b = contact.eB->id;
+		current.push_back({ std::min(a, b), std::max(a, b) });
+	}
+
+	current.insert(current.end(), kept.begin(), kept.end());
+	kept.clear();
+
+	std::sort(current.begin(), current.end());
+	current.erase(std::unique(current.begin(), current.end()), current.end());
+
+	SortedDiff::compare(previous, current,
+		[this](const ContactKey& key) { transitions.push_back({ key.a, key.b, ContactPhase::EXIT }); },
+		[this](const ContactKey& key) { transitions.push_back({ key.a, key.b, ContactPhase::ENTER }); });
+}
+
+void ContactCache::keep(unsigned long a, unsigned long b) {
+	kept.push_back({ std::min(a, b), std::max(a, b) });
+}
+
+const std::vector<ContactTransition>& ContactCache::getTransitions() const {
+	return transitions;
+}
+
+bool ContactCache::isTouching(unsigned long a, unsigned long b) const {
+	return std::binary_search(current.begin(), current.end(), ContactKey{ std::min(a, b), std::max(a, b) });
+}
+
+size_t ContactCache::size() const {
+	return current.size();
+}
+
+void ContactCache::clear() {
+	previous.clear();
+	current.clear();
+	kept.clear();
+	transitions.clear();
+}
@@ -0,0 +1,106 @@
+/**
+* @file ContactCache.h
+* @author Hudson Schumaker
+* @brief Defines the ContactCache class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Collision.h"
+#include "PhysicsTypes.h"
+
+/**
+* @struct ContactTransition
+* @brief Two entities that started or stopped touching, a being the lower id.
+*/
+struct ContactTransition {
+    unsigned long a = 0;
+    unsigned long b = 0;
+    ContactPhase phase = ContactPhase::ENTER;
+};
+
+/**
+* @class ContactCache
+* @brief Remembers the pairs of entities in contact from frame to frame and finds the ones that changed.
+*
+* The pairs of the frame are sorted and merged against the pairs of the previous frame, the
+* pairs only in the new frame entered, the pairs only in the old one exited and the others stayed.
+* Only the transitions are kept, so their listeners do work in proportion to the changes.
+*/
+class ContactCache final {
+private:
+    struct ContactKey {
+        unsigned long a = 0;
+        unsigned long b = 0;
+
+        bool operator<(const ContactKey& other) const {
+            return a < other.a || (a == other.a && b < other.b);
+        }
+
+        bool operator==(const ContactKey& other) const {
+            return a == other.a && b == other.b;
+        }
+    };
+
+    std::vector<ContactKey> previous;
+    std::vector<ContactKey> current;
+    std::vector<ContactKey> kept;
+    std::vector<ContactTransition> transitions;
+
+public:
+    ContactCache() = default;
+    ~ContactCache() = default;
+
+    /**
+    * @brief Replaces the pairs in contact by the ones of the frame, recording the transitions.
+    * @param contacts The contacts of the frame, a pair may appear several times.
+    */
+    void update(const std::vector<Collision>& contacts);
+
+    /**
+    * @brief Keeps a pair in contact through the next update without a contact, e.g. two sleeping bodies.
+    * @param a The id of an entity.
+    * @param b The id of the other entity.
+    */
+    void keep(unsigned long a, unsigned long b);
+
+    /**
+    * @brief Returns the transitions of the last update.
+    * @return Constant reference to the vector of transitions, ordered by pair.
+    */
+    const std::vector<ContactTransition>& getTransitions() const;
+
+    /**
+    * @brief Checks if two entities were in contact in the last update.
+    * @param a The id of an entity.
+    * @param b The id of the other entity.
+    * @return True if they touch, false otherwise.
+    */
+    bool isTouching(unsigned long a, unsigned long b) const;
+
+    /**
+    * @brief Returns the number of pairs in contact in the last update.
+    * @return The number of pairs.
+    */
+    size_t size() const;
+
+    /**
+    * @brief Forgets every pair without recording transitions, used when the scene changes.
+    */
+    void clear();
+};
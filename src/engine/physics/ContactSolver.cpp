@@ -0,0 +1,116 @@
+/**
+* @file ContactSolver.cpp
+* @author Hudson Schumaker
+* @brief Implements the ContactSolver class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "ContactSolver.h"
+
+void ContactSolver::setIterations(int iterations) {
+	if (iterations < 1) {
+		std::cerr << "ContactSolver: invalid number of iterations " << iterations << std::endl;
+		return;
+	}
+
+	this->iterations = iterations;
+}
+
+int ContactSolver::getIterations() const {
+	return iterations;
+}
+
+uint32_t ContactSolver::getBodyIndex(const RigidBody* body) const {
+	if (body == nullptr || body->invMass == 0.0f) {
+		return 0;
+	}
+
+	auto it = std::lower_bound(bodies.begin(), bodies.end(), body);
+	return static_cast<uint32_t>(it - bodies.begin()) + 1;
+}
+
+void ContactSolver::solve(const std::vector<Collision>& contacts) {
+	// Collect the dynamic bodies once each
+	bodies.clear();
+	for (auto& contact : contacts) {
+		if (contact.rA && contact.rA->invMass != 0.0f) {
+			bodies.push_back(contact.rA);
+		}
+		if (contact.rB && contact.rB->invMass != 0.0f) {
+			bodies.push_back(contact.rB);
+		}
+	}
+	std::sort(bodies.begin(), bodies.end());
+	bodies.erase(std::unique(bodies.begin(), bodies.end()), bodies.end());
+
+	solverBodies.resize(bodies.size() + 1);
+	solverBodies[0] = SolverBody();
+	for (size_t i = 0; i < bodies.size(); i++) {
+		solverBodies[i + 1].velocity = bodies[i]->velocity;
+		solverBodies[i + 1].invMass = bodies[i]->invMass;
+	}
+
+	// Prepare the constraints
+	constraints.clear();
+	for (auto& contact : contacts) {
+		Constraint constraint;
+		constraint.bodyA = getBodyIndex(contact.rA);
+		constraint.bodyB = getBodyIndex(contact.rB);
+
+		const SolverBody& a = solverBodies[constraint.bodyA];
+		const SolverBody& b = solverBodies[constraint.bodyB];
+		float invMassSum = a.invMass + b.invMass;
+		if (invMassSum == 0.0f) {
+			continue;
+		}
+
+		constraint.normal = contact.normal;
+		constraint.normalMass = 1.0f / invMassSum;
+
+		float normalVelocity = (b.velocity - a.velocity).dot(contact.normal);
+		if (normalVelocity < -RESTITUTION_THRESHOLD) {
+			float restitution = std::min(contact.rA ? contact.rA->restitution : 1.0f, contact.rB ? contact.rB->restitution : 1.0f);
+			constraint.targetVelocity = -restitution * normalVelocity;
+		}
+
+		constraints.push_back(constraint);
+	}
+
+	// Sequential impulses
+	for (int iteration = 0; iteration < iterations; iteration++) {
+		for (auto& constraint : constraints) {
+			SolverBody& a = solverBodies[constraint.bodyA];
+			SolverBody& b = solverBodies[constraint.bodyB];
+
+			float normalVelocity = (b.velocity - a.velocity).dot(constraint.normal);
+			float impulse = constraint.normalMass * (constraint.targetVelocity - normalVelocity);
+
+			// The contact can push the bodies apart but never pull them together
+			float accumulated = std::max(constraint.impulse + impulse, 0.0f);
+			impulse = accumulated - constraint.impulse;
+			constraint.impulse = accumulated;
+
+			a.velocity -= constraint.normal * (impulse * a.invMass);
+			b.velocity += constraint.normal * (impulse * b.invMass);
+		}
+	}
+
+	// Write the velocities back
+	for (size_t i = 0; i < bodies.size(); i++) {
+		bodies[i]->velocity = solverBodies[i + 1].velocity;
+	}
+}
@@ -0,0 +1,86 @@
+/**
+* @file ContactSolver.h
+* @author Hudson Schumaker
+* @brief Defines the ContactSolver class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Collision.h"
+
+/**
+* @class ContactSolver
+* @brief Sequential impulse solver for the velocities of all the contacts of a frame.
+*
+* The contacts are copied into a compact array of constraints that refer to a compact array
+* of bodies, so each iteration is a linear pass over contiguous memory. Every iteration
+* applies to each contact the impulse that cancels its approaching velocity, accumulating the
+* impulses so a body touching several others settles instead of jittering.
+*/
+class ContactSolver final {
+private:
+    struct SolverBody {
+        Vec2 velocity;
+        float invMass = 0.0f;
+    };
+
+    struct Constraint {
+        uint32_t bodyA = 0;
+        uint32_t bodyB = 0;
+        Vec2 normal;
+        float normalMass = 0.0f;     // 1 / (invMassA + invMassB)
+        float targetVelocity = 0.0f; // Separating velocity after the bounce
+        float impulse = 0.0f;        // Accumulated over the iterations, never negative
+    };
+
+    constexpr static const float RESTITUTION_THRESHOLD = 10.0f; // Slower impacts do not bounce, so resting bodies settle
+
+    int iterations = 8;
+    std::vector<RigidBody*> bodies;        // Sorted, the solver body of bodies[i] is solverBodies[i + 1]
+    std::vector<SolverBody> solverBodies;  // solverBodies[0] is the static body
+    std::vector<Constraint> constraints;
+
+    /**
+    * @brief Returns the index of the solver body of a rigid body.
+    * @param body Pointer to the rigid body, or nullptr.
+    * @return The index, 0 for static bodies.
+    */
+    uint32_t getBodyIndex(const RigidBody* body) const;
+
+public:
+    ContactSolver() = default;
+    ~ContactSolver() = default;
+
+    /**
+    * @brief Sets the number of passes over the contacts, more passes converge better on stacks of bodies.
+    * @param iterations The number of passes, at least 1.
+    */
+    void setIterations(int iterations);
+
+    /**
+    * @brief Returns the number of passes over the contacts.
+    * @return The number of passes.
+    */
+    int getIterations() const;
+
+    /**
+    * @brief Solves the velocities of the bodies of the contacts and writes them back to their RigidBody.
+    * @param contacts The contacts of the frame.
+    */
+    void solve(const std::vector<Collision>& contacts);
+};
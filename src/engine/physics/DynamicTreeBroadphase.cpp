@@ -0,0 +1,307 @@
+/**
+* @file DynamicTreeBroadphase.cpp
+* @author Hudson Schumaker
+* @brief Implements the DynamicTreeBroadphase class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "DynamicTreeBroadphase.h"
+#include "../ecs/Entity.h"
+
+DynamicTreeBroadphase::DynamicTreeBroadphase(float margin) {
+	if (margin < 0.0f) {
+		std::cerr << "DynamicTreeBroadphase: invalid margin " << margin << std::endl;
+		return;
+	}
+
+	this->margin = margin;
+}
+
+int DynamicTreeBroadphase::allocateNode() {
+	int node;
+	if (freeList == NULL_NODE) {
+		node = static_cast<int>(nodes.size());
+		nodes.emplace_back();
+	}
+	else {
+		// Free nodes are linked through their parent
+		node = freeList;
+		freeList = nodes[node].parent;
+		nodes[node] = Node();
+	}
+	return node;
+}
+
+void DynamicTreeBroadphase::freeNode(int node) {
+	nodes[node].parent = freeList;
+	nodes[node].height = -1;
+	freeList = node;
+}
+
+AABB DynamicTreeBroadphase::getFatBox(const ColliderProxy& proxy) const {
+	AABB box = proxy.bounds.expand(margin);
+
+	// Stretch the box ahead of the movement of the last frame
+	Vec2 displacement = (proxy.transform->position - proxy.transform->previousPosition) * 2.0f;
+	if (displacement.x < 0.0f) {
+		box.min.x += displacement.x;
+	}
+	else {
+		box.max.x += displacement.x;
+	}
+
+	if (displacement.y < 0.0f) {
+		box.min.y += displacement.y;
+	}
+	else {
+		box.max.y += displacement.y;
+	}
+	return box;
+}
+
+void DynamicTreeBroadphase::insertLeaf(int leaf) {
+	if (root == NULL_NODE) {
+		root = leaf;
+		nodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	// Walk down to the sibling with the lowest cost, the cost being the perimeter added to the tree
+	AABB leafBox = nodes[leaf].box;
+	int index = root;
+	while (!nodes[index].isLeaf()) {
+		const Node& node = nodes[index];
+		float perimeter = node.box.perimeter();
+		float combined = node.box.merge(leafBox).perimeter();
+
+		// Cost of a new parent of this node and the leaf
+		float cost = 2.0f * combined;
+
+		// Minimum cost of pushing the leaf further down
+		float inheritance = 2.0f * (combined - perimeter);
+
+		auto descendCost = [&](int child) {
+			const Node& childNode = nodes[child];
+			float childCost = leafBox.merge(childNode.box).perimeter() + inheritance;
+			return childNode.isLeaf() ? childCost : childCost - childNode.box.perimeter();
+		};
+
+		float leftCost = descendCost(node.left);
+		float rightCost = descendCost(node.right);
+
+		if (cost < leftCost && cost < rightCost) {
+			break;
+		}
+
+		index = leftCost < rightCost ? node.left : node.right;
+	}
+
+	// Pair the leaf with the sibling under a new parent
+	int sibling = index;
+	int oldParent = nodes[sibling].parent;
+	int newParent = allocateNode();
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].box = leafBox.merge(nodes[sibling].box);
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].left = sibling;
+	nodes[newParent].right = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	if (oldParent == NULL_NODE) {
+		root = newParent;
+	}
+	else if (nodes[oldParent].left == sibling) {
+		nodes[oldParent].left = newParent;
+	}
+	else {
+		nodes[oldParent].right = newParent;
+	}
+
+	refit(nodes[leaf].parent);
+}
+
+void DynamicTreeBroadphase::removeLeaf(int leaf) {
+	if (leaf == root) {
+		root = NULL_NODE;
+		return;
+	}
+
+	// The sibling takes the place of the parent
+	int parent = nodes[leaf].parent;
+	int grandParent = nodes[parent].parent;
+	int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+	nodes[sibling].parent = grandParent;
+	freeNode(parent);
+
+	if (grandParent == NULL_NODE) {
+		root = sibling;
+		return;
+	}
+
+	if (nodes[grandParent].left == parent) {
+		nodes[grandParent].left = sibling;
+	}
+	else {
+		nodes[grandParent].right = sibling;
+	}
+	refit(grandParent);
+}
+
+void DynamicTreeBroadphase::refit(int node) {
+	while (node != NULL_NODE) {
+		node = balance(node);
+
+		Node& current = nodes[node];
+		const Node& left = nodes[current.left];
+		const Node& right = nodes[current.right];
+		current.height = 1 + std::max(left.height, right.height);
+		current.box = left.box.merge(right.box);
+
+		node = current.parent;
+	}
+}
+
+int DynamicTreeBroadphase::balance(int node) {
+	if (nodes[node].isLeaf() || nodes[node].height < 2) {
+		return node;
+	}
+
+	int left = nodes[node].left;
+	int right = nodes[node].right;
+	int difference = nodes[right].height - nodes[left].height;
+	if (difference >= -1 && difference <= 1) {
+		return node;
+	}
+
+	// Rotate the taller child up, it keeps its taller child and gives the shorter one to the node
+	int up = difference > 1 ? right : left;
+	int other = up == right ? left : right;
+	int first = nodes[up].left;
+	int second = nodes[up].right;
+	int kept = nodes[first].height > nodes[second].height ? first : second;
+	int moved = kept == first ? second : first;
+
+	int parent = nodes[node].parent;
+	nodes[up].parent = parent;
+	if (parent == NULL_NODE) {
+		root = up;
+	}
+	else if (nodes[parent].left == node) {
+		nodes[parent].left = up;
+	}
+	else {
+		nodes[parent].right = up;
+	}
+
+	nodes[up].left = node;
+	nodes[up].right = kept;
+	nodes[node].parent = up;
+
+	if (nodes[node].left == up) {
+		nodes[node].left = moved;
+	}
+	else {
+		nodes[node].right = moved;
+	}
+	nodes[moved].parent = node;
+
+	nodes[node].box = nodes[other].box.merge(nodes[moved].box);
+	nodes[node].height = 1 + std::max(nodes[other].height, nodes[moved].height);
+	nodes[up].box = nodes[node].box.merge(nodes[kept].box);
+	nodes[up].height = 1 + std::max(nodes[node].height, nodes[kept].height);
+	return up;
+}
+
+int DynamicTreeBroadphase::getHeight() const {
+	return root == NULL_NODE ? 0 : nodes[root].height;
+}
+
+void DynamicTreeBroadphase::update(const std::vector<ColliderProxy>& proxies) {
+	this->proxies = &proxies;
+	updateExtent(proxies);
+	frame++;
+
+	for (size_t i = 0; i < proxies.size(); i++) {
+		const ColliderProxy& proxy = proxies[i];
+
+		int leaf;
+		auto it = leaves.find(proxy.entity->id);
+		if (it == leaves.end()) {
+			leaf = allocateNode();
+			nodes[leaf].entityId = proxy.entity->id;
+			nodes[leaf].box = getFatBox(proxy);
+			insertLeaf(leaf);
+			leaves.emplace(proxy.entity->id, leaf);
+		}
+		else {
+			// Only touch the tree when the collider left its fat box, or stopped far inside a stretched one
+			leaf = it->second;
+			AABB fatBox = getFatBox(proxy);
+			if (!nodes[leaf].box.contains(proxy.bounds) || !fatBox.expand(2.0f * margin).contains(nodes[leaf].box)) {
+				removeLeaf(leaf);
+				nodes[leaf].box = fatBox;
+				insertLeaf(leaf);
+			}
+		}
+
+		nodes[leaf].proxy = i;
+		nodes[leaf].frame = frame;
+	}
+
+	// Forget the colliders that are gone
+	for (auto it = leaves.begin(); it != leaves.end();) {
+		if (nodes[it->second].frame != frame) {
+			removeLeaf(it->second);
+			freeNode(it->second);
+			it = leaves.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+void DynamicTreeBroadphase::findPairs(std::vector<BroadphasePair>& pairs) const {
+	if (proxies == nullptr) {
+		return;
+	}
+
+	for (size_t i = 0; i < proxies->size(); i++) {
+		const ColliderProxy& proxy = (*proxies)[i];
+		traverse(proxy.bounds, [&](size_t other) {
+			// Each pair is found from both of its leaves, keep the one from the lower index
+			if (other > i && proxy.canCollide((*proxies)[other]) && proxy.bounds.overlaps((*proxies)[other].bounds)) {
+				pairs.push_back({ i, other });
+			}
+		});
+	}
+}
+
+void DynamicTreeBroadphase::query(const AABB& bounds, std::vector<size_t>& result) const {
+	if (proxies == nullptr) {
+		return;
+	}
+
+	size_t first = result.size();
+	traverse(bounds, [&](size_t proxy) {
+		if (bounds.overlaps((*proxies)[proxy].bounds)) {
+			result.push_back(proxy);
+		}
+	});
+	std::sort(result.begin() + first, result.end());
+}
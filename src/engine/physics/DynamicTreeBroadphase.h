@@ -0,0 +1,146 @@
+/**
+* @file DynamicTreeBroadphase.h
+* @author Hudson Schumaker
+* @brief Defines the DynamicTreeBroadphase class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Broadphase.h"
+
+/**
+* @class DynamicTreeBroadphase
+* @brief Broadphase over a dynamic bounding volume tree of fat AABBs, for scenes of very uneven density.
+*
+* Each collider is a leaf whose box is its bounds grown by a margin and by its last movement,
+* so a collider that moves a little stays in its leaf and the tree is left untouched. Only the
+* colliders that leave their fat box are removed and inserted again, refitting their ancestors
+* and rotating the unbalanced ones. Leaves are matched to colliders by entity id from frame to frame.
+*/
+class DynamicTreeBroadphase final : public Broadphase {
+private:
+    constexpr static const int NULL_NODE = -1;
+
+    struct Node {
+        AABB box;
+        int parent = NULL_NODE;
+        int left = NULL_NODE;
+        int right = NULL_NODE;
+        int height = 0;              // 0 for leaves, -1 for free nodes
+        size_t proxy = 0;            // Index of the proxy of the frame, leaves only
+        unsigned long entityId = 0;  // Leaves only
+        size_t frame = 0;            // Last frame the leaf was seen, leaves only
+
+        bool isLeaf() const {
+            return left == NULL_NODE;
+        }
+    };
+
+    float margin = 8.0f;
+    int root = NULL_NODE;
+    int freeList = NULL_NODE;
+    size_t frame = 0;
+    std::vector<Node> nodes;
+    std::unordered_map<unsigned long, int> leaves; // Entity id to leaf
+    const std::vector<ColliderProxy>* proxies = nullptr;
+
+    int allocateNode();
+    void freeNode(int node);
+
+    /**
+    * @brief Inserts a leaf, next to the sibling that grows the tree the least.
+    * @param leaf The leaf.
+    */
+    void insertLeaf(int leaf);
+
+    /**
+    * @brief Removes a leaf, its parent is replaced by its sibling.
+    * @param leaf The leaf.
+    */
+    void removeLeaf(int leaf);
+
+    /**
+    * @brief Refits the boxes and heights from the node to the root, rotating the unbalanced nodes.
+    * @param node The first node to refit.
+    */
+    void refit(int node);
+
+    /**
+    * @brief Rotates the node if one of its children is more than one level taller than the other.
+    * @param node The node.
+    * @return The node that took the place of the given one.
+    */
+    int balance(int node);
+
+    /**
+    * @brief Returns the fat box of a proxy, grown by the margin and by its last movement.
+    * @param proxy The proxy.
+    * @return The fat box.
+    */
+    AABB getFatBox(const ColliderProxy& proxy) const;
+
+    /**
+    * @brief Calls fn(proxyIndex) for every leaf whose fat box overlaps the bounds.
+    * @param bounds The bounds.
+    * @param fn The function to call.
+    */
+    template<typename F>
+    void traverse(const AABB& bounds, F&& fn) const {
+        if (root == NULL_NODE) {
+            return;
+        }
+
+        // One stack per thread, queries run on any thread and findPairs traverses once per proxy
+        static thread_local std::vector<int> stack;
+        stack.clear();
+        stack.push_back(root);
+
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+
+            if (!node.box.overlaps(bounds)) {
+                continue;
+            }
+
+            if (node.isLeaf()) {
+                fn(node.proxy);
+            }
+            else {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+    }
+
+public:
+    DynamicTreeBroadphase(float margin = 8.0f);
+    ~DynamicTreeBroadphase() = default;
+
+    /**
+    * @brief Returns the height of the tree, for benchmarking.
+    * @return The height, 0 for an empty tree or a single leaf.
+    */
+    int getHeight() const;
+
+    void update(const std::vector<ColliderProxy>& proxies) override;
+
+    void findPairs(std::vector<BroadphasePair>& pairs) const override;
+
+    void query(const AABB& bounds, std::vector<size_t>& result) const override;
+};
@@ -0,0 +1,165 @@
+/**
+* @file IslandManager.cpp
+* @author Hudson Schumaker
+* @brief Implements the IslandManager class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "IslandManager.h"
+
+void IslandManager::setSleepThreshold(float velocity, int frames) {
+	if (velocity < 0.0f || frames < 1) {
+		std::cerr << "IslandManager: invalid sleep threshold " << velocity << ", " << frames << std::endl;
+		return;
+	}
+
+	sleepVelocity = velocity;
+	sleepFrames = frames;
+}
+
+size_t IslandManager::getBodyIndex(const RigidBody* body) const {
+	auto it = std::lower_bound(bodies.begin(), bodies.end(), body);
+	if (it == bodies.end() || *it != body) {
+		return bodies.size();
+	}
+	return static_cast<size_t>(it - bodies.begin());
+}
+
+bool IslandManager::isResting(const Transform* transform, const RigidBody* rigidBody) {
+	return (rigidBody == nullptr || !rigidBody->isMoving || rigidBody->isSleeping) && transform->position == transform->previousPosition;
+}
+
+uint32_t IslandManager::find(uint32_t body) {
+	while (parents[body] != body) {
+		// Path halving
+		parents[body] = parents[parents[body]];
+		body = parents[body];
+	}
+	return body;
+}
+
+void IslandManager::unite(const RigidBody* a, const RigidBody* b) {
+	size_t indexA = getBodyIndex(a);
+	size_t indexB = getBodyIndex(b);
+	if (indexA == bodies.size() || indexB == bodies.size()) {
+		return;
+	}
+
+	uint32_t rootA = find(static_cast<uint32_t>(indexA));
+	uint32_t rootB = find(static_cast<uint32_t>(indexB));
+	if (rootA != rootB) {
+		parents[rootB] = rootA;
+	}
+}
+
+void IslandManager::update(const std::vector<ColliderProxy>& proxies, const std::vector<Collision>& contacts, const std::vector<BroadphasePair>& restingPairs) {
+	// Collect the dynamic bodies that may sleep, a body stopped by the game is left alone
+	bodies.clear();
+	for (const auto& proxy : proxies) {
+		RigidBody* body = proxy.rigidBody;
+		if (body == nullptr) {
+			continue;
+		}
+
+		if (!body->isMoving) {
+			// Resumes awake when the game sets it moving again
+			body->wake();
+		}
+		else if (body->invMass != 0.0f && body->canSleep) {
+			bodies.push_back(body);
+		}
+	}
+	std::sort(bodies.begin(), bodies.end());
+	bodies.erase(std::unique(bodies.begin(), bodies.end()), bodies.end());
+
+	// A sleeping body touched by anything that moves wakes up, the contact pushed it this frame
+	for (const auto& contact : contacts) {
+		bool isWokenA = contact.rA && contact.rA->isSleeping && !isResting(contact.tB, contact.rB);
+		bool isWokenB = contact.rB && contact.rB->isSleeping && !isResting(contact.tA, contact.rA);
+		if (isWokenA) {
+			contact.rA->wake();
+		}
+		if (isWokenB) {
+			contact.rB->wake();
+		}
+	}
+
+	// Count the still frames of the awake bodies
+	float sleepVelocitySquared = sleepVelocity * sleepVelocity;
+	float sleepDistanceSquared = sleepDistance * sleepDistance;
+	for (const auto& proxy : proxies) {
+		RigidBody* body = proxy.rigidBody;
+		if (body == nullptr || !body->isMoving || body->isSleeping) {
+			continue;
+		}
+
+		Vec2 displacement = proxy.transform->position - proxy.transform->previousPosition;
+		bool isStill = body->velocity.magnitudeSquared() < sleepVelocitySquared && displacement.magnitudeSquared() < sleepDistanceSquared;
+		body->stillFrames = isStill ? std::min(body->stillFrames + 1, sleepFrames) : 0;
+	}
+
+	// A body pushed by a moving body without mass, e.g. a platform on a path, is not still
+	for (const auto& contact : contacts) {
+		bool isKinematicA = contact.rA && contact.rA->invMass == 0.0f && contact.rA->velocity != Vec2::zero();
+		bool isKinematicB = contact.rB && contact.rB->invMass == 0.0f && contact.rB->velocity != Vec2::zero();
+		if (isKinematicA && contact.rB) {
+			contact.rB->stillFrames = 0;
+		}
+		if (isKinematicB && contact.rA) {
+			contact.rA->stillFrames = 0;
+		}
+	}
+
+	// Link the touching bodies into islands
+	parents.resize(bodies.size());
+	for (uint32_t i = 0; i < parents.size(); i++) {
+		parents[i] = i;
+	}
+
+	for (const auto& contact : contacts) {
+		unite(contact.rA, contact.rB);
+	}
+	for (const auto& pair : restingPairs) {
+		unite(proxies[pair.a].rigidBody, proxies[pair.b].rigidBody);
+	}
+
+	// An island is as still as its least still body
+	islandFrames.assign(bodies.size(), sleepFrames);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		uint32_t root = find(i);
+		islandFrames[root] = std::min(islandFrames[root], bodies[i]->stillFrames);
+	}
+
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		RigidBody* body = bodies[i];
+		bool isIslandStill = islandFrames[find(i)] >= sleepFrames;
+
+		if (isIslandStill && !body->isSleeping) {
+			body->sleep();
+		}
+		else if (!isIslandStill && body->isSleeping) {
+			body->wake();
+		}
+	}
+
+	// Sleeping bodies keep no velocity, a body woken later starts from the push that wakes it
+	for (const auto& proxy : proxies) {
+		if (proxy.rigidBody && proxy.rigidBody->isSleeping) {
+			proxy.rigidBody->velocity = Vec2::zero();
+		}
+	}
+}
@@ -0,0 +1,83 @@
+/**
+* @file IslandManager.h
+* @author Hudson Schumaker
+* @brief Defines the IslandManager class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Broadphase.h"
+#include "Collision.h"
+
+/**
+* @class IslandManager
+* @brief Puts to sleep the groups of touching bodies that stopped moving, and wakes them on contact.
+*
+* The dynamic bodies linked by contacts form islands, found with a union find over the contacts
+* of the frame. A body counts its consecutive frames below the sleep velocity, and an island
+* sleeps when all its bodies have been still long enough, so a settled pile sleeps as a whole.
+* Anything that moves and touches a sleeping body wakes it and its island up, whatever its mass:
+* a body that cannot sleep, e.g. the player, or a collider moved without a RigidBody.
+*/
+class IslandManager final {
+private:
+    float sleepVelocity = 5.0f;  // Pixels per second
+    float sleepDistance = 0.5f;  // Pixels per frame
+    int sleepFrames = 30;
+
+    std::vector<RigidBody*> bodies;  // Sorted
+    std::vector<uint32_t> parents;
+    std::vector<int> islandFrames;   // Fewest still frames of the island, by root
+
+    /**
+    * @brief Returns the index of a dynamic body.
+    * @param body Pointer to the rigid body, or nullptr.
+    * @return The index, or bodies.size() if it is not dynamic.
+    */
+    size_t getBodyIndex(const RigidBody* body) const;
+
+    /**
+    * @brief Checks if one side of a contact did not move in the frame, stopped, asleep or without a RigidBody.
+    * @param transform Pointer to the transform of the side.
+    * @param rigidBody Pointer to the rigid body of the side, or nullptr.
+    * @return True if it rests, false otherwise.
+    */
+    static bool isResting(const Transform* transform, const RigidBody* rigidBody);
+
+    uint32_t find(uint32_t body);
+    void unite(const RigidBody* a, const RigidBody* b);
+
+public:
+    IslandManager() = default;
+    ~IslandManager() = default;
+
+    /**
+    * @brief Sets when a body counts as still.
+    * @param velocity The velocity under which a body is still, in pixels per second.
+    * @param frames The number of still frames before an island sleeps.
+    */
+    void setSleepThreshold(float velocity, int frames);
+
+    /**
+    * @brief Updates the still frames of the bodies, then puts to sleep or wakes their islands.
+    * @param proxies The proxies of the frame.
+    * @param contacts The contacts of the frame.
+    * @param restingPairs The pairs of resting proxies that still touch but were not tested.
+    */
+    void update(const std::vector<ColliderProxy>& proxies, const std::vector<Collision>& contacts, const std::vector<BroadphasePair>& restingPairs);
+};
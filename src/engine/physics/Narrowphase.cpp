@@ -0,0 +1,249 @@
+/**
+* @file Narrowphase.cpp
+* @author Hudson Schumaker
+* @brief Implements the Narrowphase class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "Narrowphase.h"
+#include "../ecs/Entity.h"
+
+bool Narrowphase::collide(const ColliderProxy& a, const ColliderProxy& b, Collision& collision) {
+	collision = Collision();
+	bool isColliding = false;
+
+	Vec2 centerA = a.bounds.center();
+	Vec2 centerB = b.bounds.center();
+	float radiusA = (a.bounds.max.x - a.bounds.min.x) * 0.5f;
+	float radiusB = (b.bounds.max.x - b.bounds.min.x) * 0.5f;
+
+	if (a.type == ColliderType::CIRCLE && b.type == ColliderType::CIRCLE) {
+		isColliding = circleCircle(centerA, radiusA, centerB, radiusB, collision);
+	}
+	else if (a.type == ColliderType::BOX && b.type == ColliderType::BOX) {
+		isColliding = boxBox(a.bounds, b.bounds, collision);
+	}
+	else if (a.type == ColliderType::CIRCLE) {
+		isColliding = circleBox(centerA, radiusA, b.bounds, collision);
+	}
+	else {
+		// Test with the circle as A, then swap the contact back to a and b
+		isColliding = circleBox(centerB, radiusB, a.bounds, collision);
+		std::swap(collision.start, collision.end);
+		collision.normal = collision.normal * -1.0f;
+	}
+
+	if (!isColliding) {
+		return false;
+	}
+
+	collision.eA = a.entity;
+	collision.eB = b.entity;
+	collision.tA = a.transform;
+	collision.tB = b.transform;
+	collision.rA = a.rigidBody;
+	collision.rB = b.rigidBody;
+
+	if (a.type == ColliderType::CIRCLE) {
+		collision.cA = static_cast<CircleCollider*>(a.collider);
+	}
+	else {
+		collision.bA = static_cast<BoxCollider*>(a.collider);
+	}
+
+	if (b.type == ColliderType::CIRCLE) {
+		collision.cB = static_cast<CircleCollider*>(b.collider);
+	}
+	else {
+		collision.bB = static_cast<BoxCollider*>(b.collider);
+	}
+
+	return true;
+}
+
+bool Narrowphase::circleCircle(const Vec2& centerA, float radiusA, const Vec2& centerB, float radiusB, Collision& collision) {
+	Vec2 distance = centerB - centerA;
+	float radiusSum = radiusA + radiusB;
+	float squaredLength = distance.x * distance.x + distance.y * distance.y;
+
+	if (squaredLength >= radiusSum * radiusSum) {
+		return false;
+	}
+
+	// Concentric circles are pushed apart along an arbitrary axis
+	float length = std::sqrt(squaredLength);
+	collision.normal = length > 0.0f ? distance / length : Vec2::foward();
+	collision.depth = radiusSum - length;
+	collision.start = centerB - collision.normal * radiusB;
+	collision.end = centerA + collision.normal * radiusA;
+	return true;
+}
+
+bool Narrowphase::boxBox(const AABB& boxA, const AABB& boxB, Collision& collision) {
+	float overlapX = std::min(boxA.max.x, boxB.max.x) - std::max(boxA.min.x, boxB.min.x);
+	float overlapY = std::min(boxA.max.y, boxB.max.y) - std::max(boxA.min.y, boxB.min.y);
+
+	if (overlapX <= 0.0f || overlapY <= 0.0f) {
+		return false;
+	}
+
+	Vec2 centerA = boxA.center();
+	Vec2 centerB = boxB.center();
+
+	// Separate along the axis of least penetration
+	if (overlapX < overlapY) {
+		float side = centerB.x >= centerA.x ? 1.0f : -1.0f;
+		float middleY = (std::max(boxA.min.y, boxB.min.y) + std::min(boxA.max.y, boxB.max.y)) * 0.5f;
+		collision.normal = Vec2(side, 0.0f);
+		collision.depth = overlapX;
+		collision.start = Vec2(side > 0.0f ? boxB.min.x : boxB.max.x, middleY);
+	}
+	else {
+		float side = centerB.y >= centerA.y ? 1.0f : -1.0f;
+		float middleX = (std::max(boxA.min.x, boxB.min.x) + std::min(boxA.max.x, boxB.max.x)) * 0.5f;
+		collision.normal = Vec2(0.0f, side);
+		collision.depth = overlapY;
+		collision.start = Vec2(middleX, side > 0.0f ? boxB.min.y : boxB.max.y);
+	}
+
+	collision.end = collision.start + collision.normal * collision.depth;
+	return true;
+}
+
+bool Narrowphase::circleBox(const Vec2& center, float radius, const AABB& box, Collision& collision) {
+	// Closest point of the box to the center of the circle
+	Vec2 closest(std::clamp(center.x, box.min.x, box.max.x), std::clamp(center.y, box.min.y, box.max.y));
+	Vec2 distance = closest - center;
+	float squaredLength = distance.x * distance.x + distance.y * distance.y;
+
+	if (squaredLength > 0.0f) {
+		if (squaredLength >= radius * radius) {
+			return false;
+		}
+
+		float length = std::sqrt(squaredLength);
+		collision.normal = distance / length;
+		collision.depth = radius - length;
+		collision.start = closest;
+		collision.end = center + collision.normal * radius;
+		return true;
+	}
+
+	// The center is inside the box, leave through the nearest face
+	float toLeft = center.x - box.min.x;
+	float toRight = box.max.x - center.x;
+	float toTop = center.y - box.min.y;
+	float toBottom = box.max.y - center.y;
+	float nearest = std::min(std::min(toLeft, toRight), std::min(toTop, toBottom));
+
+	if (nearest == toLeft) {
+		collision.normal = Vec2(1.0f, 0.0f);
+	}
+	else if (nearest == toRight) {
+		collision.normal = Vec2(-1.0f, 0.0f);
+	}
+	else if (nearest == toTop) {
+		collision.normal = Vec2(0.0f, 1.0f);
+	}
+	else {
+		collision.normal = Vec2(0.0f, -1.0f);
+	}
+
+	collision.depth = nearest + radius;
+	collision.end = center + collision.normal * radius;
+	collision.start = collision.end - collision.normal * collision.depth;
+	return true;
+}
+
+bool Narrowphase::rayCircle(const Vec2& origin, const Vec2& direction, const Vec2& center, float radius, float& time, Vec2& normal) {
+	// Solve |origin + direction * t - center| = radius for the smallest t
+	Vec2 offset = origin - center;
+	float a = direction.dot(direction);
+	float b = offset.dot(direction);
+	float c = offset.dot(offset) - radius * radius;
+
+	if (c <= 0.0f || a == 0.0f) {
+		return false; // Starts inside, or does not move
+	}
+
+	float discriminant = b * b - a * c;
+	if (b >= 0.0f || discriminant < 0.0f) {
+		return false; // Moves away, or passes beside
+	}
+
+	float t = (-b - std::sqrt(discriminant)) / a;
+	if (t > 1.0f) {
+		return false;
+	}
+
+	time = t;
+	normal = (origin + direction * t - center) / radius;
+	return true;
+}
+
+bool Narrowphase::rayBox(const Vec2& origin, const Vec2& direction, const AABB& box, float& time, Vec2& normal) {
+	float enter = 0.0f;
+	float exit = 1.0f;
+	Vec2 enterNormal;
+	bool isInside = true;
+
+	const float origins[2] = { origin.x, origin.y };
+	const float directions[2] = { direction.x, direction.y };
+	const float mins[2] = { box.min.x, box.min.y };
+	const float maxs[2] = { box.max.x, box.max.y };
+
+	// Clip the segment against the slab of each axis
+	for (int axis = 0; axis < 2; axis++) {
+		if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+			isInside = false;
+		}
+
+		if (directions[axis] == 0.0f) {
+			if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+				return false;
+			}
+			continue;
+		}
+
+		float inverse = 1.0f / directions[axis];
+		float near = (mins[axis] - origins[axis]) * inverse;
+		float far = (maxs[axis] - origins[axis]) * inverse;
+		float side = -1.0f; // Entering through the min face
+		if (near > far) {
+			std::swap(near, far);
+			side = 1.0f;
+		}
+
+		if (near > enter) {
+			enter = near;
+			enterNormal = axis == 0 ? Vec2(side, 0.0f) : Vec2(0.0f, side);
+		}
+		exit = std::min(exit, far);
+
+		if (enter > exit) {
+			return false;
+		}
+	}
+
+	if (isInside) {
+		return false;
+	}
+
+	time = enter;
+	normal = enterNormal;
+	return true;
+}
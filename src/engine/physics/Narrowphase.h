@@ -0,0 +1,85 @@
+/**
+* @file Narrowphase.h
+* @author Hudson Schumaker
+* @brief Defines the Narrowphase class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Collision.h"
+#include "Broadphase.h"
+
+/**
+* @class Narrowphase
+* @brief Exact contact tests between the colliders of a broadphase pair.
+*
+* Box colliders are axis aligned, and circles are centered on their bounds, as computed by
+* Broadphase::computeBounds().
+*/
+class Narrowphase final {
+public:
+    /**
+    * @brief Tests two colliders and fills the contact if they touch.
+    * @param a The proxy of the first collider.
+    * @param b The proxy of the second collider.
+    * @param collision The contact to fill, with the normal pointing from a to b.
+    * @return True if the colliders touch, false otherwise.
+    */
+    static bool collide(const ColliderProxy& a, const ColliderProxy& b, Collision& collision);
+
+    /**
+    * @brief Tests two circles.
+    * @return True if the circles touch, false otherwise.
+    */
+    static bool circleCircle(const Vec2& centerA, float radiusA, const Vec2& centerB, float radiusB, Collision& collision);
+
+    /**
+    * @brief Tests two axis aligned boxes.
+    * @return True if the boxes touch, false otherwise.
+    */
+    static bool boxBox(const AABB& boxA, const AABB& boxB, Collision& collision);
+
+    /**
+    * @brief Tests a circle against an axis aligned box, the circle being A.
+    * @return True if the circle touches the box, false otherwise.
+    */
+    static bool circleBox(const Vec2& center, float radius, const AABB& box, Collision& collision);
+
+    /**
+    * @brief Finds where the segment from origin to origin + direction enters a circle.
+    * @param origin The start of the segment, outside the circle.
+    * @param direction The segment.
+    * @param center The center of the circle.
+    * @param radius The radius of the circle.
+    * @param time Receives the fraction of the segment at the entry point, between 0 and 1.
+    * @param normal Receives the normal of the circle at the entry point, pointing outwards.
+    * @return True if the segment enters the circle, false if it misses it or starts inside it.
+    */
+    static bool rayCircle(const Vec2& origin, const Vec2& direction, const Vec2& center, float radius, float& time, Vec2& normal);
+
+    /**
+    * @brief Finds where the segment from origin to origin + direction enters an axis aligned box.
+    * @param origin The start of the segment, outside the box.
+    * @param direction The segment.
+    * @param box The box.
+    * @param time Receives the fraction of the segment at the entry point, between 0 and 1.
+    * @param normal Receives the normal of the face that is entered, pointing outwards.
+    * @return True if the segment enters the box, false if it misses it or starts inside it.
+    */
+    static bool rayBox(const Vec2& origin, const Vec2& direction, const AABB& box, float& time, Vec2& normal);
+};
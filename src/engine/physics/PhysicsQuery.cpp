@@ -0,0 +1,204 @@
+/**
+* @file PhysicsQuery.cpp
+* @author Hudson Schumaker
+* @brief Implements the PhysicsQuery class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "PhysicsQuery.h"
+#include "Narrowphase.h"
+
+const std::vector<size_t>& PhysicsQuery::getCandidates(const AABB& bounds) const {
+	// One buffer per thread, the queries run on any thread without allocating
+	static thread_local std::vector<size_t> candidates;
+	candidates.clear();
+	broadphase->query(bounds, candidates);
+	return candidates;
+}
+
+float PhysicsQuery::getDistance(const ColliderProxy& proxy, const Vec2& point) {
+	const AABB& bounds = proxy.bounds;
+
+	if (proxy.type == ColliderType::CIRCLE) {
+		float radius = (bounds.max.x - bounds.min.x) * 0.5f;
+		return std::max(0.0f, (point - bounds.center()).magnitude() - radius);
+	}
+
+	float dx = std::max({ bounds.min.x - point.x, 0.0f, point.x - bounds.max.x });
+	float dy = std::max({ bounds.min.y - point.y, 0.0f, point.y - bounds.max.y });
+	return std::sqrt(dx * dx + dy * dy);
+}
+
+void PhysicsQuery::sortByDistance(const Vec2& point, std::vector<size_t>& hits, std::vector<unsigned long>& ids) const {
+	struct Key {
+		float distance;
+		float centerDistance;
+		size_t hit;
+	};
+
+	// Compute the distances once, the colliders that contain the point are ordered by their centers
+	static thread_local std::vector<Key> keys;
+	keys.clear();
+	for (size_t hit : hits) {
+		const ColliderProxy& proxy = (*proxies)[hit];
+		keys.push_back({ getDistance(proxy, point), (proxy.bounds.center() - point).magnitudeSquared(), hit });
+	}
+
+	std::sort(keys.begin(), keys.end(), [](const Key& a, const Key& b) {
+		if (a.distance != b.distance) {
+			return a.distance < b.distance;
+		}
+		if (a.centerDistance != b.centerDistance) {
+			return a.centerDistance < b.centerDistance;
+		}
+		return a.hit < b.hit;
+	});
+
+	ids.clear();
+	for (size_t i = 0; i < keys.size(); i++) {
+		hits[i] = keys[i].hit;
+		ids.push_back((*proxies)[keys[i].hit].id);
+	}
+}
+
+bool PhysicsQuery::raycast(const Vec2& origin, const Vec2& direction, float maxDistance, std::vector<RaycastHit>& hits, const QueryFilter& filter) const {
+	hits.clear();
+
+	float length = direction.magnitude();
+	if (proxies == nullptr || length == 0.0f || maxDistance <= 0.0f) {
+		return false;
+	}
+
+	// The broadphase returns the colliders around the whole segment
+	Vec2 segment = direction * (maxDistance / length);
+	Vec2 end = origin + segment;
+	AABB bounds(Vec2(std::min(origin.x, end.x), std::min(origin.y, end.y)), Vec2(std::max(origin.x, end.x), std::max(origin.y, end.y)));
+
+	for (size_t candidate : getCandidates(bounds)) {
+		const ColliderProxy& proxy = (*proxies)[candidate];
+		if (!filter.accepts(proxy)) {
+			continue;
+		}
+
+		float time = 1.0f;
+		Vec2 normal;
+		bool isHit = false;
+		if (proxy.type == ColliderType::CIRCLE) {
+			float radius = (proxy.bounds.max.x - proxy.bounds.min.x) * 0.5f;
+			isHit = Narrowphase::rayCircle(origin, segment, proxy.bounds.center(), radius, time, normal);
+		}
+		else {
+			isHit = Narrowphase::rayBox(origin, segment, proxy.bounds, time, normal);
+		}
+
+		if (isHit) {
+			hits.push_back({ proxy.id, time * maxDistance, origin + segment * time, normal });
+		}
+	}
+
+	std::sort(hits.begin(), hits.end(), [](const RaycastHit& a, const RaycastHit& b) {
+		return a.distance < b.distance || (a.distance == b.distance && a.id < b.id);
+	});
+	return !hits.empty();
+}
+
+bool PhysicsQuery::overlapCircle(const Vec2& center, float radius, std::vector<unsigned long>& ids, const QueryFilter& filter) const {
+	ids.clear();
+	if (proxies == nullptr) {
+		return false;
+	}
+
+	static thread_local std::vector<size_t> hits;
+	hits.clear();
+
+	AABB bounds(Vec2(center.x - radius, center.y - radius), Vec2(center.x + radius, center.y + radius));
+	for (size_t candidate : getCandidates(bounds)) {
+		const ColliderProxy& proxy = (*proxies)[candidate];
+		if (filter.accepts(proxy) && getDistance(proxy, center) <= radius) {
+			hits.push_back(candidate);
+		}
+	}
+
+	sortByDistance(center, hits, ids);
+	return !ids.empty();
+}
+
+bool PhysicsQuery::overlapBox(const AABB& box, std::vector<unsigned long>& ids, const QueryFilter& filter) const {
+	ids.clear();
+	if (proxies == nullptr) {
+		return false;
+	}
+
+	static thread_local std::vector<size_t> hits;
+	hits.clear();
+
+	for (size_t candidate : getCandidates(box)) {
+		const ColliderProxy& proxy = (*proxies)[candidate];
+		if (!filter.accepts(proxy)) {
+			continue;
+		}
+
+		// The candidates overlap the box, only the corners of the box can miss a circle
+		if (proxy.type == ColliderType::CIRCLE) {
+			Vec2 center = proxy.bounds.center();
+			Vec2 closest(std::clamp(center.x, box.min.x, box.max.x), std::clamp(center.y, box.min.y, box.max.y));
+			if (getDistance(proxy, closest) > 0.0f) {
+				continue;
+			}
+		}
+		hits.push_back(candidate);
+	}
+
+	sortByDistance(box.center(), hits, ids);
+	return !ids.empty();
+}
+
+bool PhysicsQuery::nearest(const Vec2& point, float maxDistance, unsigned long& id, const QueryFilter& filter) const {
+	if (proxies == nullptr || proxies->empty() || maxDistance < 0.0f) {
+		return false;
+	}
+
+	// A collider within the distance of the point touches the square of that size around it,
+	// so the closest one found within the distance is the closest of all
+	const AABB& extent = broadphase->getExtent();
+	float distance = std::min(64.0f, maxDistance);
+	while (true) {
+		AABB bounds(Vec2(point.x - distance, point.y - distance), Vec2(point.x + distance, point.y + distance));
+
+		float best = distance;
+		bool isFound = false;
+		for (size_t candidate : getCandidates(bounds)) {
+			const ColliderProxy& proxy = (*proxies)[candidate];
+			if (!filter.accepts(proxy)) {
+				continue;
+			}
+
+			float candidateDistance = getDistance(proxy, point);
+			if (candidateDistance < best || (candidateDistance == best && (!isFound || proxy.id < id))) {
+				best = candidateDistance;
+				id = proxy.id;
+				isFound = true;
+			}
+		}
+
+		// Once the square covers every collider, growing it cannot find more
+		if (isFound || distance >= maxDistance || bounds.contains(extent)) {
+			return isFound;
+		}
+		distance = std::min(distance * 2.0f, maxDistance);
+	}
+}
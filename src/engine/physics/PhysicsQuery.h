@@ -0,0 +1,139 @@
+/**
+* @file PhysicsQuery.h
+* @author Hudson Schumaker
+* @brief Defines the PhysicsQuery class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Broadphase.h"
+
+/**
+* @struct QueryFilter
+* @brief The tags a query accepts, all of them by default.
+*/
+struct QueryFilter {
+    uint32_t tags = ~0u;
+
+    QueryFilter() = default;
+    QueryFilter(std::initializer_list<Tag> tags) {
+        this->tags = 0;
+        for (Tag tag : tags) {
+            this->tags |= CollisionMatrix::getCategory(tag);
+        }
+    }
+
+    bool accepts(const ColliderProxy& proxy) const {
+        return (tags & proxy.category) != 0;
+    }
+};
+
+/**
+* @struct RaycastHit
+* @brief A collider crossed by a ray.
+*/
+struct RaycastHit {
+    unsigned long id = 0;
+    float distance = 0.0f; // From the origin of the ray to the point
+    Vec2 point;
+    Vec2 normal;           // Of the surface at the point, pointing outwards
+};
+
+/**
+* @class PhysicsQuery
+* @brief Read only queries over the colliders of the last CollisionSystem update, served by its broadphase.
+*
+* The queries only read the proxies and the broadphase of that update, so any number of
+* threads may run them at the same time, as long as the CollisionSystem does not update
+* meanwhile. Systems that query should read Transform, so the SystemScheduler never runs them
+* alongside the CollisionSystem. The results are entity ids sorted by distance, the entities
+* may have been removed since the update.
+*/
+class PhysicsQuery final {
+private:
+    const Broadphase* broadphase = nullptr;
+    const std::vector<ColliderProxy>* proxies = nullptr;
+
+    /**
+    * @brief Returns the candidates of the broadphase in the bounds, in a buffer of the calling thread.
+    * @param bounds The bounds.
+    * @return Reference to the buffer of the indices of the proxies.
+    */
+    const std::vector<size_t>& getCandidates(const AABB& bounds) const;
+
+    /**
+    * @brief Returns the distance from a point to the surface of a collider, 0 inside it.
+    * @param proxy The proxy.
+    * @param point The point.
+    * @return The distance.
+    */
+    static float getDistance(const ColliderProxy& proxy, const Vec2& point);
+
+    /**
+    * @brief Sorts the proxies by the distance of their surface to a point, then of their center.
+    * @param point The point.
+    * @param hits The indices of the proxies, sorted in place.
+    * @param ids The vector that receives their ids in that order, cleared first.
+    */
+    void sortByDistance(const Vec2& point, std::vector<size_t>& hits, std::vector<unsigned long>& ids) const;
+
+public:
+    PhysicsQuery() = default;
+    PhysicsQuery(const Broadphase* broadphase, const std::vector<ColliderProxy>* proxies) : broadphase(broadphase), proxies(proxies) {}
+    ~PhysicsQuery() = default;
+
+    /**
+    * @brief Finds the colliders along a ray, the ones the ray starts inside are skipped.
+    * @param origin The start of the ray.
+    * @param direction The direction of the ray, need not be normalized.
+    * @param maxDistance The length of the ray.
+    * @param hits The vector that receives the hits sorted by distance, cleared first.
+    * @param filter The tags to accept.
+    * @return True if the ray hit something, false otherwise.
+    */
+    bool raycast(const Vec2& origin, const Vec2& direction, float maxDistance, std::vector<RaycastHit>& hits, const QueryFilter& filter = QueryFilter()) const;
+
+    /**
+    * @brief Finds the colliders that overlap a circle.
+    * @param center The center of the circle.
+    * @param radius The radius of the circle.
+    * @param ids The vector that receives the ids sorted by distance to the center, cleared first.
+    * @param filter The tags to accept.
+    * @return True if something overlaps the circle, false otherwise.
+    */
+    bool overlapCircle(const Vec2& center, float radius, std::vector<unsigned long>& ids, const QueryFilter& filter = QueryFilter()) const;
+
+    /**
+    * @brief Finds the colliders that overlap a box.
+    * @param box The box.
+    * @param ids The vector that receives the ids sorted by distance to the center of the box, cleared first.
+    * @param filter The tags to accept.
+    * @return True if something overlaps the box, false otherwise.
+    */
+    bool overlapBox(const AABB& box, std::vector<unsigned long>& ids, const QueryFilter& filter = QueryFilter()) const;
+
+    /**
+    * @brief Finds the collider closest to a point, searching in growing squares up to a distance.
+    * @param point The point.
+    * @param maxDistance The largest distance to search.
+    * @param id Receives the id of the closest collider.
+    * @param filter The tags to accept.
+    * @return True if a collider was found, false otherwise.
+    */
+    bool nearest(const Vec2& point, float maxDistance, unsigned long& id, const QueryFilter& filter = QueryFilter()) const;
+};
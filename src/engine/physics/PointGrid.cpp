@@ -0,0 +1,52 @@
+/**
+* @file PointGrid.cpp
+* @author Hudson Schumaker
+* @brief Implements the PointGrid class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "PointGrid.h"
+
+void PointGrid::setCellSize(float cellSize) {
+	if (cellSize <= 0.0f) {
+		std::cerr << "PointGrid: invalid cell size " << cellSize << std::endl;
+		return;
+	}
+
+	this->cellSize = cellSize;
+	this->invCellSize = 1.0f / cellSize;
+}
+
+void PointGrid::clear() {
+	points.clear();
+	entries.clear();
+}
+
+void PointGrid::add(Tag tag, const Vec2& position, unsigned long id) {
+	points.push_back({ position, id, tag });
+}
+
+void PointGrid::build() {
+	entries.resize(points.size());
+	for (size_t i = 0; i < points.size(); i++) {
+		const Point& point = points[i];
+		entries[i] = { getKey(point.tag, getCell(point.position.x), getCell(point.position.y)), static_cast<uint32_t>(i) };
+	}
+
+	// Group the records of the same tag and cell together
+	std::sort(entries.begin(), entries.end());
+}
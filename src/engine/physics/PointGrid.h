@@ -0,0 +1,136 @@
+/**
+* @file PointGrid.h
+* @author Hudson Schumaker
+* @brief Defines the PointGrid class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "../ecs/TLG.h"
+#include "../math/Vec2.h"
+
+/**
+* @class PointGrid
+* @brief Uniform grid of tagged points, to find the points of a tag around a position.
+*
+* The points are recorded with the key of their tag and cell, and the records are sorted once
+* per build, so the points of a tag in a cell are contiguous and found with a binary search.
+* Works best with a cell size about the size of the query radius, a query then visits at
+* most 3 x 3 cells.
+*/
+class PointGrid final {
+public:
+    struct Point {
+        Vec2 position;
+        unsigned long id = 0;
+        Tag tag = Tag::STANDARD;
+    };
+
+private:
+    struct CellEntry {
+        uint64_t key = 0;
+        uint32_t point = 0;
+
+        bool operator<(const CellEntry& other) const {
+            return key < other.key || (key == other.key && point < other.point);
+        }
+    };
+
+    float cellSize = 64.0f;
+    float invCellSize = 1.0f / 64.0f;
+    std::vector<Point> points;
+    std::vector<CellEntry> entries;
+
+    /**
+    * @brief Returns the key of a cell of a tag, the tag in the top 8 bits and 28 bits per coordinate.
+    * @param tag The tag.
+    * @param x The column of the cell.
+    * @param y The row of the cell.
+    * @return The key.
+    */
+    static uint64_t getKey(Tag tag, int x, int y) {
+        constexpr uint64_t COORDINATE_MASK = (1ull << 28) - 1;
+        return (static_cast<uint64_t>(tag) << 56) |
+            ((static_cast<uint64_t>(static_cast<uint32_t>(x)) & COORDINATE_MASK) << 28) |
+            (static_cast<uint64_t>(static_cast<uint32_t>(y)) & COORDINATE_MASK);
+    }
+
+    int getCell(float coordinate) const {
+        return static_cast<int>(std::floor(coordinate * invCellSize));
+    }
+
+public:
+    PointGrid() = default;
+    ~PointGrid() = default;
+
+    /**
+    * @brief Sets the size of the cells, used from the next build.
+    * @param cellSize The size, greater than 0.
+    */
+    void setCellSize(float cellSize);
+
+    /**
+    * @brief Removes all the points.
+    */
+    void clear();
+
+    /**
+    * @brief Adds a point, found after the next build.
+    * @param tag The tag of the point.
+    * @param position The position of the point.
+    * @param id The id of the entity of the point.
+    */
+    void add(Tag tag, const Vec2& position, unsigned long id);
+
+    /**
+    * @brief Sorts the points into their cells.
+    */
+    void build();
+
+    /**
+    * @brief Calls fn(point, distanceSquared) for every point of the tag within the radius of the center.
+    * @param tag The tag of the points.
+    * @param center The center of the query.
+    * @param radius The radius of the query.
+    * @param fn The function to call.
+    */
+    template<typename F>
+    void query(Tag tag, const Vec2& center, float radius, F&& fn) const {
+        float radiusSquared = radius * radius;
+        int minX = getCell(center.x - radius);
+        int maxX = getCell(center.x + radius);
+        int minY = getCell(center.y - radius);
+        int maxY = getCell(center.y + radius);
+
+        for (int x = minX; x <= maxX; x++) {
+            for (int y = minY; y <= maxY; y++) {
+                // The records of the cell are contiguous
+                CellEntry cell = { getKey(tag, x, y), 0 };
+                for (auto it = std::lower_bound(entries.begin(), entries.end(), cell); it != entries.end() && it->key == cell.key; ++it) {
+                    const Point& point = points[it->point];
+                    float dx = point.position.x - center.x;
+                    float dy = point.position.y - center.y;
+                    float distanceSquared = dx * dx + dy * dy;
+                    if (distanceSquared <= radiusSquared) {
+                        fn(point, distanceSquared);
+                    }
+                }
+            }
+        }
+    }
+};
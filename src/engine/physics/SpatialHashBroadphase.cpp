@@ -0,0 +1,141 @@
+/**
+* @file SpatialHashBroadphase.cpp
+* @author Hudson Schumaker
+* @brief Implements the SpatialHashBroadphase class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "SpatialHashBroadphase.h"
+
+SpatialHashBroadphase::SpatialHashBroadphase(float cellSize) {
+	setCellSize(cellSize);
+}
+
+void SpatialHashBroadphase::setCellSize(float cellSize) {
+	if (cellSize <= 0.0f) {
+		std::cerr << "SpatialHashBroadphase: invalid cell size " << cellSize << std::endl;
+		return;
+	}
+
+	this->cellSize = cellSize;
+	this->invCellSize = 1.0f / cellSize;
+}
+
+SpatialHashBroadphase::CellRange SpatialHashBroadphase::getRange(const AABB& bounds) const {
+	CellRange range;
+	range.minX = static_cast<int>(std::floor(bounds.min.x * invCellSize));
+	range.minY = static_cast<int>(std::floor(bounds.min.y * invCellSize));
+	range.maxX = static_cast<int>(std::floor(bounds.max.x * invCellSize));
+	range.maxY = static_cast<int>(std::floor(bounds.max.y * invCellSize));
+	return range;
+}
+
+void SpatialHashBroadphase::update(const std::vector<ColliderProxy>& proxies) {
+	this->proxies = &proxies;
+	updateExtent(proxies);
+	ranges.resize(proxies.size());
+	entries.clear();
+
+	// Record each proxy in every cell it touches
+	for (size_t i = 0; i < proxies.size(); i++) {
+		CellRange range = getRange(proxies[i].bounds);
+		ranges[i] = range;
+
+		for (int y = range.minY; y <= range.maxY; y++) {
+			for (int x = range.minX; x <= range.maxX; x++) {
+				entries.push_back({ getKey(x, y), static_cast<uint32_t>(i) });
+			}
+		}
+	}
+
+	// Group the records of the same cell together
+	std::sort(entries.begin(), entries.end());
+}
+
+void SpatialHashBroadphase::findPairs(std::vector<BroadphasePair>& pairs) const {
+	if (proxies == nullptr) {
+		return;
+	}
+
+	size_t begin = 0;
+	while (begin < entries.size()) {
+		// Find the records of the cell
+		size_t end = begin + 1;
+		while (end < entries.size() && entries[end].key == entries[begin].key) {
+			end++;
+		}
+
+		int cellX = static_cast<int>(static_cast<uint32_t>(entries[begin].key >> 32));
+		int cellY = static_cast<int>(static_cast<uint32_t>(entries[begin].key));
+
+		for (size_t i = begin; i < end; i++) {
+			uint32_t a = entries[i].proxy;
+			const CellRange& rangeA = ranges[a];
+
+			for (size_t j = i + 1; j < end; j++) {
+				uint32_t b = entries[j].proxy;
+				const CellRange& rangeB = ranges[b];
+
+				// Report the pair only from the first cell both proxies share
+				if (cellX != std::max(rangeA.minX, rangeB.minX) || cellY != std::max(rangeA.minY, rangeB.minY)) {
+					continue;
+				}
+
+				const ColliderProxy& proxyA = (*proxies)[a];
+				const ColliderProxy& proxyB = (*proxies)[b];
+				if (proxyA.canCollide(proxyB) && proxyA.bounds.overlaps(proxyB.bounds)) {
+					pairs.push_back({ a, b }); // a < b, the records of a cell are sorted by proxy
+				}
+			}
+		}
+
+		begin = end;
+	}
+}
+
+void SpatialHashBroadphase::query(const AABB& bounds, std::vector<size_t>& result) const {
+	if (proxies == nullptr || proxies->empty() || !bounds.overlaps(extent)) {
+		return;
+	}
+
+	// Only the occupied cells are walked, huge bounds would visit billions of empty ones
+	AABB clamped(
+		Vec2(std::max(bounds.min.x, extent.min.x), std::max(bounds.min.y, extent.min.y)),
+		Vec2(std::min(bounds.max.x, extent.max.x), std::min(bounds.max.y, extent.max.y))
+	);
+
+	size_t first = result.size();
+	CellRange range = getRange(clamped);
+
+	for (int y = range.minY; y <= range.maxY; y++) {
+		for (int x = range.minX; x <= range.maxX; x++) {
+			// The records of the cell are contiguous
+			CellEntry cell = { getKey(x, y), 0 };
+			auto it = std::lower_bound(entries.begin(), entries.end(), cell);
+
+			for (; it != entries.end() && it->key == cell.key; ++it) {
+				if ((*proxies)[it->proxy].bounds.overlaps(bounds)) {
+					result.push_back(it->proxy);
+				}
+			}
+		}
+	}
+
+	// Proxies that span several cells were found once per cell
+	std::sort(result.begin() + first, result.end());
+	result.erase(std::unique(result.begin() + first, result.end()), result.end());
+}
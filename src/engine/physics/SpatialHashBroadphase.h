@@ -0,0 +1,91 @@
+/**
+* @file SpatialHashBroadphase.h
+* @author Hudson Schumaker
+* @brief Defines the SpatialHashBroadphase class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Broadphase.h"
+
+/**
+* @class SpatialHashBroadphase
+* @brief Broadphase over a uniform grid of square cells, hashed so the world has no bounds.
+*
+* Every proxy is recorded in each cell its bounds touch, the records are sorted by cell and
+* only the proxies that share a cell are tested against each other. A pair that shares several
+* cells is only reported by the first of them, so no pair is reported twice. Works best with
+* a cell size about the size of the common colliders.
+*/
+class SpatialHashBroadphase final : public Broadphase {
+private:
+    struct CellEntry {
+        uint64_t key = 0;
+        uint32_t proxy = 0;
+
+        bool operator<(const CellEntry& other) const {
+            return key < other.key || (key == other.key && proxy < other.proxy);
+        }
+    };
+
+    struct CellRange {
+        int minX = 0;
+        int minY = 0;
+        int maxX = 0;
+        int maxY = 0;
+    };
+
+    float cellSize = 64.0f;
+    float invCellSize = 1.0f / 64.0f;
+    const std::vector<ColliderProxy>* proxies = nullptr;
+    std::vector<CellRange> ranges;
+    std::vector<CellEntry> entries;
+
+    /**
+    * @brief Returns the hash key of a cell.
+    * @param x The column of the cell.
+    * @param y The row of the cell.
+    * @return The key.
+    */
+    static uint64_t getKey(int x, int y) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+
+    /**
+    * @brief Returns the cells covered by the bounds.
+    * @param bounds The bounds.
+    * @return The range of cells.
+    */
+    CellRange getRange(const AABB& bounds) const;
+
+public:
+    SpatialHashBroadphase(float cellSize = 64.0f);
+    ~SpatialHashBroadphase() = default;
+
+    /**
+    * @brief Sets the size of the cells, applied on the next update.
+    * @param cellSize The size of the side of a cell, in pixels.
+    */
+    void setCellSize(float cellSize);
+
+    void update(const std::vector<ColliderProxy>& proxies) override;
+
+    void findPairs(std::vector<BroadphasePair>& pairs) const override;
+
+    void query(const AABB& bounds, std::vector<size_t>& result) const override;
+};
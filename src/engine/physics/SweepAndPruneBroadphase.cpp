@@ -0,0 +1,255 @@
+/**
+* @file SweepAndPruneBroadphase.cpp
+* @author Hudson Schumaker
+* @brief Implements the SweepAndPruneBroadphase class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "SweepAndPruneBroadphase.h"
+#include "../ecs/Entity.h"
+
+SweepAndPruneBroadphase::SweepAndPruneBroadphase(SweepAxis axis) : axis(axis) {}
+
+void SweepAndPruneBroadphase::addPair(uint32_t a, uint32_t b) {
+	if (pairIndices.emplace(getPairKey(a, b), pairs.size()).second) {
+		pairs.push_back({ a, b });
+	}
+}
+
+void SweepAndPruneBroadphase::removePair(uint32_t a, uint32_t b) {
+	auto it = pairIndices.find(getPairKey(a, b));
+	if (it == pairIndices.end()) {
+		return;
+	}
+
+	// Swap with the last pair and pop
+	size_t index = it->second;
+	pairIndices.erase(it);
+	if (index != pairs.size() - 1) {
+		pairs[index] = pairs.back();
+		pairIndices[getPairKey(pairs[index].a, pairs[index].b)] = index;
+	}
+	pairs.pop_back();
+}
+
+void SweepAndPruneBroadphase::sortEndpoints() {
+	for (size_t i = 1; i < endpoints.size(); i++) {
+		Endpoint endpoint = endpoints[i];
+		size_t j = i;
+
+		while (j > 0 && endpoint < endpoints[j - 1]) {
+			const Endpoint& passed = endpoints[j - 1];
+			if (endpoint.isMax() != passed.isMax() && endpoint.getSlot() != passed.getSlot()) {
+				if (endpoint.isMax()) {
+					// An end moved before a begin, the intervals no longer overlap
+					removePair(endpoint.getSlot(), passed.getSlot());
+				}
+				else if (!slots[endpoint.getSlot()].isFree && !slots[passed.getSlot()].isFree) {
+					// A begin moved before an end, the intervals start to overlap
+					addPair(endpoint.getSlot(), passed.getSlot());
+				}
+			}
+
+			endpoints[j] = passed;
+			j--;
+		}
+		endpoints[j] = endpoint;
+	}
+}
+
+void SweepAndPruneBroadphase::rebuildEndpoints() {
+	std::sort(endpoints.begin(), endpoints.end());
+	pairs.clear();
+	pairIndices.clear();
+
+	// Every begin overlaps the intervals that are open when it is reached
+	std::vector<uint32_t> open;
+	for (const auto& endpoint : endpoints) {
+		uint32_t slot = endpoint.getSlot();
+		if (slots[slot].isFree) {
+			continue;
+		}
+
+		if (endpoint.isMax()) {
+			auto it = std::find(open.begin(), open.end(), slot);
+			*it = open.back();
+			open.pop_back();
+		}
+		else {
+			for (uint32_t other : open) {
+				addPair(other, slot);
+			}
+			open.push_back(slot);
+		}
+	}
+}
+
+SweepAxis SweepAndPruneBroadphase::chooseAxis(const std::vector<ColliderProxy>& proxies) const {
+	if (proxies.size() < 2) {
+		return axis;
+	}
+
+	// Variance of the centers on each axis
+	Vec2 sum;
+	Vec2 sumSquares;
+	for (const auto& proxy : proxies) {
+		Vec2 center = (proxy.bounds.min + proxy.bounds.max) * 0.5f;
+		sum += center;
+		sumSquares += Vec2(center.x * center.x, center.y * center.y);
+	}
+	float count = static_cast<float>(proxies.size());
+	float spreadX = sumSquares.x / count - (sum.x / count) * (sum.x / count);
+	float spreadY = sumSquares.y / count - (sum.y / count) * (sum.y / count);
+
+	if (axis == SweepAxis::Y && spreadX > spreadY * AXIS_SWITCH_RATIO) {
+		return SweepAxis::X;
+	}
+	if (axis == SweepAxis::X && spreadY > spreadX * AXIS_SWITCH_RATIO) {
+		return SweepAxis::Y;
+	}
+	return axis;
+}
+
+void SweepAndPruneBroadphase::removeFreeSlots() {
+	// The freed endpoints sorted past every live one, their pairs already ended
+	while (!endpoints.empty() && slots[endpoints.back().getSlot()].isFree) {
+		if (!endpoints.back().isMax()) {
+			freeSlots.push_back(endpoints.back().getSlot());
+		}
+		endpoints.pop_back();
+	}
+}
+
+void SweepAndPruneBroadphase::update(const std::vector<ColliderProxy>& proxies) {
+	this->proxies = &proxies;
+	updateExtent(proxies);
+	frame++;
+
+	for (size_t i = 0; i < proxies.size(); i++) {
+		unsigned long id = proxies[i].entity->id;
+
+		uint32_t slot;
+		auto it = slotsById.find(id);
+		if (it == slotsById.end()) {
+			if (freeSlots.empty()) {
+				slot = static_cast<uint32_t>(slots.size());
+				slots.emplace_back();
+			}
+			else {
+				slot = freeSlots.back();
+				freeSlots.pop_back();
+			}
+
+			slots[slot] = Slot();
+			slots[slot].entityId = id;
+			slotsById.emplace(id, slot);
+
+			// New intervals start past the end of the list, overlapping nothing, and sort into place
+			endpoints.push_back({ 0.0f, slot << 1 });
+			endpoints.push_back({ 0.0f, (slot << 1) | 1 });
+		}
+		else {
+			slot = it->second;
+		}
+
+		slots[slot].proxy = i;
+		slots[slot].frame = frame;
+	}
+
+	// Forget the colliders that are gone, their slots are recycled once their endpoints are popped
+	for (auto it = slotsById.begin(); it != slotsById.end();) {
+		Slot& slot = slots[it->second];
+		if (slot.frame != frame) {
+			slot.isFree = true;
+			it = slotsById.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+
+	SweepAxis sweepAxis = chooseAxis(proxies);
+	bool isAxisChanged = sweepAxis != axis;
+	axis = sweepAxis;
+
+	// Move the endpoints to the bounds of the frame, the freed ones past the end, then restore the order
+	for (auto& endpoint : endpoints) {
+		const Slot& slot = slots[endpoint.getSlot()];
+		if (slot.isFree) {
+			// Every end before every begin, so the pairs between freed slots end as well
+			endpoint.value = endpoint.isMax() ? std::numeric_limits<float>::max() : std::numeric_limits<float>::infinity();
+			continue;
+		}
+
+		const AABB& bounds = proxies[slot.proxy].bounds;
+		endpoint.value = endpoint.isMax() ? getMax(bounds) : getMin(bounds);
+	}
+
+	maxExtent = 0.0f;
+	for (const auto& proxy : proxies) {
+		maxExtent = std::max(maxExtent, getMax(proxy.bounds) - getMin(proxy.bounds));
+	}
+
+	if (isAxisChanged) {
+		rebuildEndpoints();
+	}
+	else {
+		sortEndpoints();
+	}
+	removeFreeSlots();
+}
+
+void SweepAndPruneBroadphase::findPairs(std::vector<BroadphasePair>& pairs) const {
+	if (proxies == nullptr) {
+		return;
+	}
+
+	for (const auto& pair : this->pairs) {
+		size_t a = slots[pair.a].proxy;
+		size_t b = slots[pair.b].proxy;
+
+		// The pairs overlap on the axis, test the other one
+		const ColliderProxy& proxyA = (*proxies)[a];
+		const ColliderProxy& proxyB = (*proxies)[b];
+		if (proxyA.canCollide(proxyB) && proxyA.bounds.overlaps(proxyB.bounds)) {
+			pairs.push_back({ std::min(a, b), std::max(a, b) });
+		}
+	}
+}
+
+void SweepAndPruneBroadphase::query(const AABB& bounds, std::vector<size_t>& result) const {
+	if (proxies == nullptr) {
+		return;
+	}
+
+	// No interval that overlaps the bounds begins before their start minus the longest interval
+	size_t first = result.size();
+	Endpoint start = { getMin(bounds) - maxExtent, 0 };
+	float end = getMax(bounds);
+
+	for (auto it = std::lower_bound(endpoints.begin(), endpoints.end(), start); it != endpoints.end() && it->value <= end; ++it) {
+		if (it->isMax()) {
+			continue;
+		}
+
+		size_t proxy = slots[it->getSlot()].proxy;
+		if (bounds.overlaps((*proxies)[proxy].bounds)) {
+			result.push_back(proxy);
+		}
+	}
+	std::sort(result.begin() + first, result.end());
+}
@@ -0,0 +1,143 @@
+/**
+* @file SweepAndPruneBroadphase.h
+* @author Hudson Schumaker
+* @brief Defines the SweepAndPruneBroadphase class.
+* @version 1.0.0
+*
+* Dodoi-Engine is a game engine developed by Dodoi-Lab.
+* @copyright Copyright (c) 2024, Dodoi-Lab
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+#include "../../Pch.h"
+#include "Broadphase.h"
+
+/**
+* @class SweepAndPruneBroadphase
+* @brief Broadphase over a persistent sorted list of the interval endpoints of the colliders on one axis.
+*
+* The endpoints are kept sorted from frame to frame with an insertion sort, which is close to
+* linear when the order of the colliders on the axis barely changes between frames. Every swap
+* of a begin and an end endpoint starts or ends the overlap of two intervals, so the overlapping
+* pairs are maintained incrementally instead of being searched again. Colliders are matched from
+* frame to frame by entity id, the pairs are tested on the other axis when they are reported.
+*
+* The sweep runs on the axis along which the colliders spread the most, so a row of colliders
+* does not make every pair overlap on the axis; the list is sorted again when the axis changes.
+* The endpoints of removed colliders are moved past the end of the list, the sort ends their
+* pairs on the way, and they are popped from the back.
+*/
+class SweepAndPruneBroadphase final : public Broadphase {
+private:
+    struct Endpoint {
+        float value = 0.0f;
+        uint32_t data = 0; // Slot << 1 | 1 for the end of the interval
+
+        uint32_t getSlot() const {
+            return data >> 1;
+        }
+
+        bool isMax() const {
+            return (data & 1) != 0;
+        }
+
+        /**
+        * @brief Orders by value, a begin before an end of the same value so touching intervals overlap.
+        */
+        bool operator<(const Endpoint& other) const {
+            return value < other.value || (value == other.value && !isMax() && other.isMax());
+        }
+    };
+
+    struct Slot {
+        unsigned long entityId = 0;
+        size_t proxy = 0;
+        size_t frame = 0;
+        bool isFree = false;
+    };
+
+    struct SlotPair {
+        uint32_t a = 0;
+        uint32_t b = 0;
+    };
+
+    constexpr static const float AXIS_SWITCH_RATIO = 2.0f; // Spread the other axis needs over the current one to switch
+
+    SweepAxis axis = SweepAxis::Y;
+    size_t frame = 0;
+    float maxExtent = 0.0f; // Longest interval of the frame, bounds the queries
+    std::vector<Endpoint> endpoints;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::unordered_map<unsigned long, uint32_t> slotsById;
+    std::vector<SlotPair> pairs; // Slots whose intervals overlap on the axis
+    std::unordered_map<uint64_t, size_t> pairIndices;
+    const std::vector<ColliderProxy>* proxies = nullptr;
+
+    /**
+    * @brief Returns the key of the pair of two slots, in any order.
+    * @param a The first slot.
+    * @param b The second slot.
+    * @return The key.
+    */
+    static uint64_t getPairKey(uint32_t a, uint32_t b) {
+        if (a > b) {
+            std::swap(a, b);
+        }
+        return (static_cast<uint64_t>(a) << 32) | b;
+    }
+
+    float getMin(const AABB& bounds) const {
+        return axis == SweepAxis::X ? bounds.min.x : bounds.min.y;
+    }
+
+    float getMax(const AABB& bounds) const {
+        return axis == SweepAxis::X ? bounds.max.x : bounds.max.y;
+    }
+
+    void addPair(uint32_t a, uint32_t b);
+    void removePair(uint32_t a, uint32_t b);
+
+    /**
+    * @brief Sorts the endpoints, starting and ending the overlaps of the swapped intervals.
+    */
+    void sortEndpoints();
+
+    /**
+    * @brief Sorts the endpoints from scratch and finds the pairs again with a sweep, after the axis changed.
+    */
+    void rebuildEndpoints();
+
+    /**
+    * @brief Returns the axis along which the centers of the proxies spread the most, or the current one unless the other spreads clearly more.
+    * @param proxies The proxies of all the colliders.
+    * @return The axis to sweep.
+    */
+    SweepAxis chooseAxis(const std::vector<ColliderProxy>& proxies) const;
+
+    /**
+    * @brief Pops the endpoints of the freed slots from the back of the sorted list and recycles the slots.
+    */
+    void removeFreeSlots();
+
+public:
+    SweepAndPruneBroadphase(SweepAxis axis = SweepAxis::Y);
+    ~SweepAndPruneBroadphase() = default;
+
+    void update(const std::vector<ColliderProxy>& proxies) override;
+
+    void findPairs(std::vector<BroadphasePair>& pairs) const override;
+
+    void query(const AABB& bounds, std::vector<size_t>& result) const override;
+};
@@ -60,6 +60,17 @@ public:
 		sound = AssetManager::getInstance()->getSound(soundId);
 	}
 
+	Audio(const Audio&) = default;
+
+	/**
+	* @brief Moves the audio, e.g. into the column of an archetype. The moved-from audio no longer stops the sound.
+	* @param other The audio to move.
+	*/
+	Audio(Audio&& other) : Audio(other) {
+		other.channel = -1;
+		other.delay = 0;
+	}
+
 	~Audio() {
 		if (delay != 0) {
 			stop(delay);
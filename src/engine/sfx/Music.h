@@ -33,6 +33,7 @@
 class Music final : public Component {
 private:
 	bool paused = false;
+	bool isOwner = true; // False once moved, the moved-from music does not stop the music
 
 public:
 	std::string musicPath;
@@ -66,7 +67,21 @@ public:
 	/**
 	* @brief Destructor that stops the music. If delay is non-zero, the music will fade out over the specified delay.
 	*/
+	Music(const Music&) = default;
+
+	/**
+	* @brief Moves the music, e.g. into the column of an archetype. The moved-from music no longer stops the music.
+	* @param other The music to move.
+	*/
+	Music(Music&& other) : Music(other) {
+		other.isOwner = false;
+	}
+
 	~Music() {
+		if (!isOwner) {
+			return;
+		}
+
 		if (delay != 0) {
 			stop(delay);
 		}
@@ -28,7 +28,6 @@
 #include "../engine/ecs/component/RigidBody.h"
 #include "../engine/ecs/system/RenderSystem.h"
 #include "../engine/ecs/system/PrimitiveRenderSystem.h"
-#include "../engine/ecs/system/WaypointNavigationSystem.h"
 
 TitleScreen::TitleScreen() : Scene() {}
 TitleScreen::~TitleScreen() {
@@ -49,6 +48,10 @@ void TitleScreen::load() {
 	pressSpacebar = Gfx::getInstance()->createText("HemiHead.ttf", "- press spacebar to start -", 28, { 255, 0, 0, 255 });
 	pressSpacebarRect = Gfx::getInstance()->getTextureBounds(pressSpacebar);
 
+	// Added in the order they would be called by hand, the navigation writes the velocities the movement reads
+	scheduler.add(&waypointNavigationSystem, [this] { waypointNavigationSystem.update(deltaTime); });
+	scheduler.add(&movementSystem, [this] { movementSystem.update(deltaTime); });
+
 	isRunning = true;
 }
 
@@ -75,7 +78,9 @@ void TitleScreen::input() {
 }
 
 void TitleScreen::update() {
-	float dt = calculateDeltaTime();
+	deltaTime = calculateDeltaTime();
+	EntityManager::getInstance()->update();
+	scheduler.run();
 }
 
 void TitleScreen::render() {
@@ -93,5 +98,6 @@ void TitleScreen::render() {
 
 void TitleScreen::unload() {
 	isLoaded = false;
+	scheduler.clear();
 	SDL_DestroyTexture(logoTexture);
 }
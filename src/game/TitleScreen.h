@@ -21,6 +21,8 @@
 */
 #pragma once
 #include "../engine/core/Scene.h"
+#include "../engine/ecs/system/MovementSystem.h"
+#include "../engine/ecs/system/WaypointNavigationSystem.h"
 
 /**
 * @class TitleScreen
@@ -36,6 +38,9 @@ private:
 
 	short speed = 8;
 
+	WaypointNavigationSystem waypointNavigationSystem;
+	MovementSystem movementSystem;
+
 	void load() override;
 	void input() override;
 	void update() override;